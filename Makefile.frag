@@ -16,3 +16,13 @@ realclean: distclean
 	rm -rf acinclude.m4 aclocal.m4 autom4te.cache build config.guess config.h config.h.in config.nice config.sub configure configure.in .deps include install-sh ltmain.sh Makefile.global missing mkinstalldirs modules
 
 .PHONY: realclean
+
+PDO_INFORMIX_BENCH_ARGS = -d extension=$(top_builddir)/modules/pdo_informix.so
+
+bench-micro: all
+	$(PHP_EXECUTABLE) $(PDO_INFORMIX_BENCH_ARGS) $(srcdir)/bench/micro.php $(BENCH_ARGS)
+
+bench: all
+	$(PHP_EXECUTABLE) $(PDO_INFORMIX_BENCH_ARGS) $(srcdir)/bench/run.php $(BENCH_ARGS)
+
+.PHONY: bench-micro bench
@@ -0,0 +1,145 @@
+<?php
+/*
+ * Microbenchmarks for the hot paths of the driver.
+ *
+ * Meant to be run against an extension built with
+ * --enable-pdo-informix-mock, so that the numbers measure the driver and
+ * not the server or the network:
+ *
+ *   make bench-micro
+ *   make bench-micro BENCH_ARGS="--iterations=50000 --filter=fetch"
+ *
+ * The shape of each result set is given by a {mock ...} comment, which the
+ * mock CLI reads and a real server ignores.  Set PDO_INFORMIX_BENCH_DSN
+ * (and PDO_INFORMIX_BENCH_USER/PASSWORD) to point the same statements at a
+ * real server instead.
+ */
+
+$iterations = 10000;
+$filter = null;
+foreach (array_slice($argv, 1) as $arg) {
+	if (strncmp($arg, '--iterations=', 13) == 0) {
+		$iterations = max(1, (int) substr($arg, 13));
+	} else if (strncmp($arg, '--filter=', 9) == 0) {
+		$filter = substr($arg, 9);
+	} else {
+		fwrite(STDERR, "usage: micro.php [--iterations=N] [--filter=NAME]\n");
+		exit(1);
+	}
+}
+
+$dsn = getenv('PDO_INFORMIX_BENCH_DSN');
+if ($dsn === false || $dsn === '') {
+	$dsn = 'informix:mock';
+}
+$db = new PDO($dsn, getenv('PDO_INFORMIX_BENCH_USER'), getenv('PDO_INFORMIX_BENCH_PASSWORD'),
+	array(PDO::ATTR_ERRMODE => PDO::ERRMODE_EXCEPTION));
+
+/* each benchmark returns the number of operations it timed */
+$benchmarks = array(
+	'prepare' => 'bench_prepare',
+	'execute' => 'bench_execute',
+	'fetch_row' => 'bench_fetch_row',
+	'fetch_lazy' => 'bench_fetch_lazy',
+	'bind_param' => 'bench_bind_param',
+	'quote' => 'bench_quote',
+	'lob_stream' => 'bench_lob_stream',
+);
+
+function bench_prepare($db, $n)
+{
+	for ($i = 0; $i < $n; $i++) {
+		$stmt = $db->prepare("SELECT tabid, tabname FROM systables WHERE tabid = ?");
+		$stmt = null;
+	}
+	return $n;
+}
+
+function bench_execute($db, $n)
+{
+	$stmt = $db->prepare("UPDATE {mock rows=1} systables SET tabname = tabname WHERE tabid = ?");
+	for ($i = 0; $i < $n; $i++) {
+		$stmt->execute(array($i));
+	}
+	return $n;
+}
+
+function bench_fetch_row($db, $n)
+{
+	$stmt = $db->prepare("SELECT {mock rows=$n types=isfts width=32} tabid, tabname, nrows, created, owner FROM systables");
+	$stmt->execute();
+	$rows = 0;
+	while ($stmt->fetch(PDO::FETCH_NUM)) {
+		$rows++;
+	}
+	return $rows;
+}
+
+/* one column of a wide row, with only that column read */
+function bench_fetch_lazy($db, $n)
+{
+	$stmt = $db->prepare("SELECT {mock rows=$n cols=40 types=isft width=32} * FROM bench_wide",
+		array(PDO::INFORMIX_ATTR_LAZY_FETCH => true));
+	$stmt->execute();
+	$rows = 0;
+	while ($stmt->fetchColumn(1) !== false) {
+		$rows++;
+	}
+	return $rows;
+}
+
+function bench_bind_param($db, $n)
+{
+	$params = 10;
+	$stmt = $db->prepare("INSERT INTO bench VALUES (" . implode(', ', array_fill(0, $params, '?')) . ")");
+	$value = str_repeat('x', 32);
+	$rounds = max(1, (int) ($n / $params));
+	for ($i = 0; $i < $rounds; $i++) {
+		for ($p = 1; $p <= $params; $p++) {
+			$stmt->bindValue($p, $value, PDO::PARAM_STR);
+		}
+		$stmt->execute();
+	}
+	return $rounds * $params;
+}
+
+function bench_quote($db, $n)
+{
+	$value = str_repeat("O'Brien, ", 8);
+	for ($i = 0; $i < $n; $i++) {
+		$db->quote($value);
+	}
+	return $n;
+}
+
+/* reports bytes rather than operations */
+function bench_lob_stream($db, $n)
+{
+	$rows = max(1, (int) ($n / 100));
+	$stmt = $db->prepare("SELECT {mock rows=$rows types=c lob=1048576} body FROM bench_lob");
+	$stmt->execute();
+	$stmt->bindColumn(1, $lob, PDO::PARAM_LOB);
+	$bytes = 0;
+	while ($stmt->fetch(PDO::FETCH_BOUND)) {
+		while (!feof($lob)) {
+			$bytes += strlen(fread($lob, 65536));
+		}
+	}
+	return $bytes;
+}
+
+printf("%-12s %12s %12s %14s %14s\n", 'benchmark', 'ops', 'total ms', 'ns/op', 'ops/s');
+foreach ($benchmarks as $name => $function) {
+	if ($filter !== null && strpos($name, $filter) === false) {
+		continue;
+	}
+	/* one short untimed run to warm up caches and the allocator */
+	$function($db, max(1, (int) ($iterations / 100)));
+
+	$start = microtime(true);
+	$ops = $function($db, $iterations);
+	$elapsed = microtime(true) - $start;
+
+	printf("%-12s %12d %12.2f %14.1f %14.0f\n", $name, $ops, $elapsed * 1000,
+		$elapsed * 1e9 / $ops, $elapsed > 0 ? $ops / $elapsed : 0);
+}
@@ -0,0 +1,301 @@
+<?php
+/*
+ * End-to-end performance regression suite.
+ *
+ * Runs a handful of workloads through the driver, built either against a
+ * real server (a local developer container is enough) or the mock CLI, and
+ * prints throughput and latency percentiles for each:
+ *
+ *   lob_roundtrip   insert and read back the LOB fixtures from tests/
+ *   batch_insert    prepared inserts, committed every batch
+ *   small_queries   many single row lookups
+ *   wide_rows       fetching every row of a 40 column table
+ *   scroll          random and relative moves of a scrollable cursor
+ *
+ * Usage:
+ *
+ *   make bench BENCH_ARGS="--save-baseline=base.json"   on the old code
+ *   make bench BENCH_ARGS="--baseline=base.json"        on the new code
+ *
+ * With --baseline, each result is compared with the stored one and the run
+ * exits with status 2 when any throughput drops, or any p50/p99 latency
+ * rises, by more than --tolerance percent (default 10).  Baselines are only
+ * meaningful on the machine and DSN they were recorded with.
+ *
+ * The DSN comes from PDO_INFORMIX_BENCH_DSN, then PDOTEST_DSN as used by the
+ * tests, and defaults to "informix:mock".  Tables named bench_* are dropped
+ * and recreated.
+ */
+
+$options = array(
+	'rounds' => 1,
+	'only' => null,
+	'baseline' => null,
+	'save-baseline' => null,
+	'tolerance' => 10,
+);
+foreach (array_slice($argv, 1) as $arg) {
+	if (preg_match('/^--([a-z-]+)=(.*)$/', $arg, $m) && array_key_exists($m[1], $options)) {
+		$options[$m[1]] = $m[2];
+	} else {
+		fwrite(STDERR, "usage: run.php [--rounds=N] [--only=WORKLOAD] [--baseline=FILE]\n" .
+			"               [--save-baseline=FILE] [--tolerance=PERCENT]\n");
+		exit(1);
+	}
+}
+$rounds = max(1, (int) $options['rounds']);
+
+$dsn = getenv('PDO_INFORMIX_BENCH_DSN');
+$user = getenv('PDO_INFORMIX_BENCH_USER');
+$pass = getenv('PDO_INFORMIX_BENCH_PASSWORD');
+if ($dsn === false || $dsn === '') {
+	$dsn = getenv('PDOTEST_DSN');
+	$user = getenv('PDOTEST_USER');
+	$pass = getenv('PDOTEST_PASS');
+}
+if ($dsn === false || $dsn === '') {
+	$dsn = 'informix:mock';
+}
+$db = new PDO($dsn, $user, $pass, array(PDO::ATTR_ERRMODE => PDO::ERRMODE_EXCEPTION));
+$fixtures = dirname(__FILE__) . '/../tests';
+
+/*
+ * A workload returns array(latencies in seconds, units processed, unit name).
+ * The {mock ...} comments give the mock CLI the shape a real server would
+ * return; a server ignores them.
+ */
+
+function drop_table($db, $table)
+{
+	try {
+		$db->exec("DROP TABLE $table");
+	} catch (PDOException $e) {
+	}
+}
+
+function workload_lob_roundtrip($db, $rounds)
+{
+	global $fixtures;
+	$pairs = array(
+		array("$fixtures/clob.dat", "$fixtures/spook.png"),
+		array("$fixtures/large_clob.dat", "$fixtures/large_blob.dat"),
+	);
+
+	drop_table($db, 'bench_lob');
+	$db->exec('CREATE TABLE bench_lob (id INTEGER, c TEXT, b BYTE)');
+	$insert = $db->prepare('INSERT INTO bench_lob (id, c, b) VALUES (?, ?, ?)');
+
+	$latencies = array();
+	$bytes = 0;
+	for ($i = 0; $i < 20 * $rounds; $i++) {
+		list($clob_file, $blob_file) = $pairs[$i % count($pairs)];
+		$lob_size = max(filesize($clob_file), filesize($blob_file));
+		$select = $db->prepare("SELECT {mock rows=1 types=icb lob=$lob_size} id, c, b FROM bench_lob WHERE id = ?");
+
+		$start = microtime(true);
+		$clob = fopen($clob_file, 'rb');
+		$blob = fopen($blob_file, 'rb');
+		$insert->bindValue(1, $i, PDO::PARAM_INT);
+		$insert->bindParam(2, $clob, PDO::PARAM_LOB);
+		$insert->bindParam(3, $blob, PDO::PARAM_LOB);
+		$insert->execute();
+		fclose($clob);
+		fclose($blob);
+
+		$select->execute(array($i));
+		$select->bindColumn(2, $c, PDO::PARAM_LOB);
+		$select->bindColumn(3, $b, PDO::PARAM_LOB);
+		while ($select->fetch(PDO::FETCH_BOUND)) {
+			$bytes += strlen(is_resource($c) ? stream_get_contents($c) : $c);
+			$bytes += strlen(is_resource($b) ? stream_get_contents($b) : $b);
+		}
+		$latencies[] = microtime(true) - $start;
+		$bytes += filesize($clob_file) + filesize($blob_file);
+	}
+	return array($latencies, $bytes / 1048576, 'MB');
+}
+
+function workload_batch_insert($db, $rounds)
+{
+	drop_table($db, 'bench_rows');
+	$db->exec('CREATE TABLE bench_rows (id INTEGER, name VARCHAR(64), amount DECIMAL(10,2), created DATETIME YEAR TO SECOND)');
+	$insert = $db->prepare('INSERT INTO bench_rows (id, name, amount, created) VALUES (?, ?, ?, ?)');
+
+	$batch = 500;
+	$latencies = array();
+	$rows = 0;
+	for ($i = 0; $i < 4 * $rounds; $i++) {
+		$start = microtime(true);
+		$db->beginTransaction();
+		for ($j = 0; $j < $batch; $j++, $rows++) {
+			$insert->execute(array($rows, "row $rows", $rows / 100, '2026-01-01 00:00:00'));
+		}
+		$db->commit();
+		$latencies[] = microtime(true) - $start;
+	}
+	return array($latencies, $rows, 'rows');
+}
+
+function workload_small_queries($db, $rounds)
+{
+	$select = $db->prepare('SELECT {mock rows=1 types=isf} id, name, amount FROM bench_rows WHERE id = ?');
+
+	$latencies = array();
+	for ($i = 0; $i < 2000 * $rounds; $i++) {
+		$start = microtime(true);
+		$select->execute(array($i % 2000));
+		$select->fetchAll(PDO::FETCH_NUM);
+		$latencies[] = microtime(true) - $start;
+	}
+	return array($latencies, count($latencies), 'queries');
+}
+
+function workload_wide_rows($db, $rounds)
+{
+	$columns = 40;
+	$names = array();
+	$definitions = array();
+	for ($i = 0; $i < $columns; $i++) {
+		$names[] = "c$i";
+		$definitions[] = $i % 2 ? "c$i VARCHAR(40)" : "c$i INTEGER";
+	}
+	drop_table($db, 'bench_wide');
+	$db->exec('CREATE TABLE bench_wide (' . implode(', ', $definitions) . ')');
+
+	$insert = $db->prepare('INSERT INTO bench_wide VALUES (' . implode(', ', array_fill(0, $columns, '?')) . ')');
+	$values = array();
+	for ($i = 0; $i < $columns; $i++) {
+		$values[] = $i % 2 ? str_repeat(chr(ord('a') + $i % 26), 40) : $i;
+	}
+	$db->beginTransaction();
+	for ($i = 0; $i < 500; $i++) {
+		$insert->execute($values);
+	}
+	$db->commit();
+
+	$select = $db->prepare("SELECT {mock rows=500 cols=$columns types=is width=40} " . implode(', ', $names) . ' FROM bench_wide');
+	$latencies = array();
+	$rows = 0;
+	for ($i = 0; $i < 10 * $rounds; $i++) {
+		$start = microtime(true);
+		$select->execute();
+		while ($select->fetch(PDO::FETCH_NUM)) {
+			$rows++;
+		}
+		$latencies[] = microtime(true) - $start;
+	}
+	return array($latencies, $rows, 'rows');
+}
+
+function workload_scroll($db, $rounds)
+{
+	$select = $db->prepare('SELECT {mock rows=2000 types=isf} id, name, amount FROM bench_rows ORDER BY id',
+		array(PDO::ATTR_CURSOR => PDO::CURSOR_SCROLL));
+	$select->execute();
+	mt_srand(42);
+
+	$latencies = array();
+	for ($i = 0; $i < 2000 * $rounds; $i++) {
+		$start = microtime(true);
+		switch ($i % 4) {
+			case 0:
+				$select->fetch(PDO::FETCH_NUM, PDO::FETCH_ORI_ABS, mt_rand(1, 2000));
+				break;
+			case 1:
+				$select->fetch(PDO::FETCH_NUM, PDO::FETCH_ORI_PRIOR);
+				break;
+			case 2:
+				$select->fetch(PDO::FETCH_NUM, PDO::FETCH_ORI_REL, 10);
+				break;
+			default:
+				$select->fetch(PDO::FETCH_NUM, PDO::FETCH_ORI_LAST);
+				break;
+		}
+		$latencies[] = microtime(true) - $start;
+	}
+	$select->closeCursor();
+	return array($latencies, count($latencies), 'moves');
+}
+
+/* nearest rank percentile of a sorted list */
+function percentile($sorted, $p)
+{
+	$rank = (int) ceil($p / 100 * count($sorted));
+	return $sorted[max(0, $rank - 1)];
+}
+
+function compare($label, $now, $then, $higher_is_better, $tolerance, &$regressions)
+{
+	if ($then <= 0) {
+		return '';
+	}
+	$change = ($now - $then) / $then * 100;
+	$worse = $higher_is_better ? -$change : $change;
+	if ($worse > $tolerance) {
+		$regressions[] = sprintf('%s %+.1f%%', $label, $change);
+		return sprintf(' %s %+.1f%% !', $label, $change);
+	}
+	return sprintf(' %s %+.1f%%', $label, $change);
+}
+
+$workloads = array('lob_roundtrip', 'batch_insert', 'small_queries', 'wide_rows', 'scroll');
+
+$baseline = null;
+if ($options['baseline'] !== null) {
+	$baseline = json_decode(file_get_contents($options['baseline']), true);
+	if (!is_array($baseline)) {
+		fwrite(STDERR, "cannot read baseline {$options['baseline']}\n");
+		exit(1);
+	}
+}
+
+printf("%s, %d round(s)\n\n", $dsn, $rounds);
+printf("%-14s %16s %10s %10s %10s\n", 'workload', 'throughput', 'p50 ms', 'p90 ms', 'p99 ms');
+
+$results = array();
+$regressions = array();
+foreach ($workloads as $name) {
+	/* batch_insert fills the table the lookups and the scrolling read */
+	if ($options['only'] !== null && $options['only'] !== $name && $name !== 'batch_insert') {
+		continue;
+	}
+	$function = "workload_$name";
+	$wall = microtime(true);
+	list($latencies, $units, $unit) = $function($db, $rounds);
+	$wall = microtime(true) - $wall;
+	sort($latencies);
+
+	$result = array(
+		'throughput' => $wall > 0 ? $units / $wall : 0,
+		'unit' => "$unit/s",
+		'p50' => percentile($latencies, 50) * 1000,
+		'p90' => percentile($latencies, 90) * 1000,
+		'p99' => percentile($latencies, 99) * 1000,
+	);
+	$results[$name] = $result;
+
+	$line = sprintf("%-14s %10.1f %-5s %10.3f %10.3f %10.3f", $name, $result['throughput'],
+		$result['unit'], $result['p50'], $result['p90'], $result['p99']);
+	if ($baseline !== null && isset($baseline[$name])) {
+		$line .= ' |' . compare('thr', $result['throughput'], $baseline[$name]['throughput'], true,
+			$options['tolerance'], $regressions);
+		$line .= compare('p50', $result['p50'], $baseline[$name]['p50'], false,
+			$options['tolerance'], $regressions);
+		$line .= compare('p99', $result['p99'], $baseline[$name]['p99'], false,
+			$options['tolerance'], $regressions);
+	}
+	echo "$line\n";
+}
+
+foreach (array('bench_lob', 'bench_rows', 'bench_wide') as $table) {
+	drop_table($db, $table);
+}
+
+if ($options['save-baseline'] !== null) {
+	file_put_contents($options['save-baseline'], json_encode($results));
+	echo "\nbaseline saved to {$options['save-baseline']}\n";
+}
+if (count($regressions) > 0) {
+	printf("\n%d regression(s) beyond %s%%\n", count($regressions), $options['tolerance']);
+	exit(2);
+}
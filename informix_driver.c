@@ -32,9 +32,16 @@
 #include "php_pdo_informix_int.h"
 #include "zend_exceptions.h"
 #include <stdio.h>
+#include <ctype.h>
+#include <limits.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 extern struct pdo_stmt_methods informix_stmt_methods;
 extern int informix_stmt_dtor(pdo_stmt_t *stmt TSRMLS_DC);
+static const char *sql_match_keyword(const char *p, const char *end, const char *keyword);
+static int sql_is_select_for_update(const char *sql, long sql_len);
 
 
 /* allocate and initialize the driver_data portion of a PDOStatement object. */
@@ -63,6 +70,7 @@ static int dbh_prepare_stmt(pdo_dbh_t *dbh, pdo_stmt_t *stmt, const char *stmt_s
 	SQLSMALLINT param_count;
 	UCHAR server_info[30];
 	SQLSMALLINT server_len = 0;
+	double start;
 
 	/* in case we need to convert the statement for positional syntax */
 	int converted_len = 0;
@@ -105,10 +113,62 @@ static int dbh_prepare_stmt(pdo_dbh_t *dbh, pdo_stmt_t *stmt, const char *stmt_s
 		return FALSE;
 	}
 
+	if (conn_res->reset_on_reuse || conn_res->session_tuned) {
+		informix_session_track(dbh, stmt_string, stmt_len TSRMLS_CC);
+	}
+
+	/* statistics are off unless asked for here or on the connection */
+	stmt_res->collect_stats = pdo_attr_lval(driver_options, PDO_INFORMIX_ATTR_STATS,
+			conn_res->collect_stats TSRMLS_CC) ? 1 : 0;
+	INFORMIX_STATS_START(stmt_res, start);
+
 	/* alloc handle and return only if it errors */
 	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn_res->hdbc, &(stmt_res->hstmt));
 	check_stmt_error(rc, "SQLAllocHandle");
 
+	/* the tunables default to the connection's */
+	stmt_res->lob_chunk_size = pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_LOB_CHUNK_SIZE, conn_res->lob_chunk_size TSRMLS_CC);
+	if (stmt_res->lob_chunk_size <= 0) {
+		stmt_res->lob_chunk_size = LOB_BUFFER_SIZE;
+	}
+	stmt_res->temporal_mode = pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_TEMPORAL_MODE, conn_res->temporal_mode TSRMLS_CC);
+	if (!INFORMIX_TEMPORAL_MODE_VALID(stmt_res->temporal_mode)) {
+		RAISE_INFORMIX_STMT_ERROR("HY024", "prepare", "Invalid temporal mode");
+		return FALSE;
+	}
+	/*
+	 * Only queries hand out LO pointers; everything else keeps automatic LO
+	 * transfer, so that BLOB and CLOB parameters can be bound from strings
+	 * and streams on a smart LOB connection too.
+	 */
+	stmt_res->smart_lob = conn_res->smart_lob &&
+		sql_match_keyword(stmt_string, stmt_string + stmt_len, "SELECT") != NULL;
+	if (stmt_res->smart_lob) {
+		rc = SQLSetStmtAttr(stmt_res->hstmt, SQL_INFX_ATTR_LO_AUTOMATIC,
+				(SQLPOINTER) SQL_FALSE, 0);
+		check_stmt_error(rc, "SQLSetStmtAttr");
+	}
+	/* smart LOBs selected FOR UPDATE are opened for writing unless told otherwise */
+	stmt_res->lob_writable = pdo_attr_lval(driver_options, PDO_INFORMIX_ATTR_LOB_WRITABLE,
+			stmt_res->smart_lob && sql_is_select_for_update(stmt_string, stmt_len) TSRMLS_CC) ? 1 : 0;
+	stmt_res->max_bind_size = pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_MAX_BIND_SIZE, conn_res->max_bind_size TSRMLS_CC);
+	if (stmt_res->max_bind_size < 0) {
+		stmt_res->max_bind_size = 0;
+	}
+	stmt_res->lazy_fetch = pdo_attr_lval(driver_options, PDO_INFORMIX_ATTR_LAZY_FETCH,
+			conn_res->lazy_fetch TSRMLS_CC) ? 1 : 0;
+	stmt_res->getdata_ordered = !(conn_res->getdata_ext & SQL_GD_ANY_ORDER);
+	stmt_res->query_timeout = pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_QUERY_TIMEOUT, conn_res->query_timeout TSRMLS_CC);
+	if (stmt_res->query_timeout > 0) {
+		rc = SQLSetStmtAttr(stmt_res->hstmt, SQL_ATTR_QUERY_TIMEOUT,
+				(SQLPOINTER) stmt_res->query_timeout, 0);
+		check_stmt_error(rc, "SQLSetStmtAttr");
+	}
+
 	/* now see if the cursor type has been explicitly specified. */
 	stmt_res->cursor_type = pdo_attr_lval(driver_options, PDO_ATTR_CURSOR, 
 			PDO_CURSOR_FWDONLY TSRMLS_CC);
@@ -145,6 +205,7 @@ static int dbh_prepare_stmt(pdo_dbh_t *dbh, pdo_stmt_t *stmt, const char *stmt_s
 
 	/* we're responsible for setting the column_count for the PDO driver. */
 	stmt->column_count = param_count;
+	INFORMIX_STATS_STOP(stmt_res, prepare_time, start, 3);
 
 	/* Get the server information:
 	 * server_info is in this form:
@@ -160,6 +221,7 @@ static int dbh_prepare_stmt(pdo_dbh_t *dbh, pdo_stmt_t *stmt, const char *stmt_s
 	 * force cleanup of the stmt driver-specific storage.
 	 */
 	stmt->methods = &informix_stmt_methods;
+	PDO_INFORMIX_G(statements_prepared)++;
 
 	return TRUE;
 }
@@ -176,6 +238,516 @@ static void current_error_state(pdo_dbh_t *dbh)
 		conn_res->error_data.lineno);		/* location of the reported error */
 }
 
+/*
+* The statement handle used for statements run without a PDOStatement
+* (PDO::exec() and the driver's own housekeeping SQL).  It is allocated on
+* first use and kept for the life of the connection; callers close it with
+* SQLFreeStmt(SQL_CLOSE) when they are done, rather than freeing it.
+*/
+static SQLHANDLE informix_exec_handle(pdo_dbh_t *dbh, conn_handle *conn_res TSRMLS_DC)
+{
+	if (conn_res->hstmt_exec == SQL_NULL_HANDLE) {
+		int rc = SQLAllocHandle(SQL_HANDLE_STMT, conn_res->hdbc, &conn_res->hstmt_exec);
+		if (rc == SQL_ERROR) {
+			if (dbh != NULL) {
+				RAISE_DBH_ERROR("SQLAllocHandle");
+			}
+			conn_res->hstmt_exec = SQL_NULL_HANDLE;
+		} else if (conn_res->query_timeout > 0) {
+			SQLSetStmtAttr(conn_res->hstmt_exec, SQL_ATTR_QUERY_TIMEOUT,
+					(SQLPOINTER) conn_res->query_timeout, 0);
+		}
+	}
+	return conn_res->hstmt_exec;
+}
+
+/*
+* Directly execute a driver-generated statement on a connection.  When a
+* dbh is given, a failure is reported to PDO; otherwise the caller only
+* gets the return code.
+*/
+static int informix_exec_direct(pdo_dbh_t *dbh, conn_handle *conn_res, char *sql, int sql_len TSRMLS_DC)
+{
+	int rc;
+	SQLHANDLE hstmt = informix_exec_handle(dbh, conn_res TSRMLS_CC);
+	if (hstmt == SQL_NULL_HANDLE) {
+		return SQL_ERROR;
+	}
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) sql, sql_len);
+	if (rc == SQL_ERROR && dbh != NULL) {
+		/* raise the error before closing the handle to get the right record */
+		raise_sql_error(dbh, NULL, hstmt, SQL_HANDLE_STMT,
+			"SQLExecDirect", __FILE__, __LINE__ TSRMLS_CC);
+		/* an error while connecting closes the connection, handle and all */
+		if (dbh->driver_data == NULL) {
+			return rc;
+		}
+	}
+	SQLFreeStmt(hstmt, SQL_CLOSE);
+	return rc;
+}
+
+/*
+* Match a keyword at the start of an SQL fragment, ignoring case and any
+* leading white space.  Returns the position after the keyword, or NULL.
+*/
+static const char *sql_match_keyword(const char *p, const char *end, const char *keyword)
+{
+	int len = strlen(keyword);
+
+	while (p < end && isspace((unsigned char) *p)) {
+		p++;
+	}
+	if (end - p < len || strncasecmp(p, keyword, len) != 0) {
+		return NULL;
+	}
+	p += len;
+	if (p < end && (isalnum((unsigned char) *p) || *p == '_')) {
+		return NULL;
+	}
+	return p;
+}
+
+/*
+* Is this a SELECT ... FOR UPDATE?  Quoted text is skipped, so that a FOR
+* UPDATE inside a string literal does not count.
+*/
+static int sql_is_select_for_update(const char *sql, long sql_len)
+{
+	const char *end = sql + sql_len;
+	const char *p;
+	char quote = 0;
+
+	if ((p = sql_match_keyword(sql, end, "SELECT")) == NULL) {
+		return 0;
+	}
+	for (; p < end; p++) {
+		if (quote) {
+			if (*p == quote) {
+				quote = 0;
+			}
+		} else if (*p == '\'' || *p == '"') {
+			quote = *p;
+		} else if ((*p == 'F' || *p == 'f') && isspace((unsigned char) p[-1])) {
+			const char *q = sql_match_keyword(p, end, "FOR");
+			if (q != NULL && sql_match_keyword(q, end, "UPDATE") != NULL) {
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+/* remember a temp table created by the request so the reset can drop it */
+static void session_add_temp_table(conn_handle *conn_res, const char *p, const char *end)
+{
+	const char *name;
+
+	while (p < end && isspace((unsigned char) *p)) {
+		p++;
+	}
+	name = p;
+	while (p < end && (isalnum((unsigned char) *p) || *p == '_')) {
+		p++;
+	}
+	if (p == name) {
+		return;
+	}
+	smart_str_appendl_ex(&conn_res->temp_tables, "DROP TABLE ", sizeof("DROP TABLE ") - 1, 1);
+	smart_str_appendl_ex(&conn_res->temp_tables, name, p - name, 1);
+	smart_str_appendc_ex(&conn_res->temp_tables, ';', 1);
+	conn_res->session_dirty |= INFORMIX_SESSION_TEMP_TABLES;
+}
+
+/* link a connection into the list of connections the request has to reset */
+static void session_mark(conn_handle *conn_res, unsigned int what TSRMLS_DC)
+{
+	conn_res->session_dirty |= what;
+	if (!conn_res->session_listed) {
+		conn_res->next_dirty = PDO_INFORMIX_G(dirty_conns);
+		PDO_INFORMIX_G(dirty_conns) = conn_res;
+		conn_res->session_listed = 1;
+	}
+}
+
+/* unlink a connection from the request's reset list, keeping what it changed */
+static void session_unlink(conn_handle *conn_res TSRMLS_DC)
+{
+	conn_handle **link;
+
+	if (conn_res->session_listed) {
+		for (link = &PDO_INFORMIX_G(dirty_conns); *link != NULL; link = &(*link)->next_dirty) {
+			if (*link == conn_res) {
+				*link = conn_res->next_dirty;
+				break;
+			}
+		}
+		conn_res->next_dirty = NULL;
+		conn_res->session_listed = 0;
+	}
+}
+
+/* unlink a connection from the request's reset list */
+static void session_forget(conn_handle *conn_res TSRMLS_DC)
+{
+	session_unlink(conn_res TSRMLS_CC);
+	smart_str_free_ex(&conn_res->temp_tables, 1);
+	conn_res->session_dirty = 0;
+}
+
+/*
+* Look at a statement about to be run on a connection that has reset on
+* reuse enabled or tuned session settings, and note any session setting
+* it changes.  Only the leading keywords are inspected, so this stays
+* cheap for ordinary DML.
+*/
+void informix_session_track(pdo_dbh_t *dbh, const char *sql, long sql_len TSRMLS_DC)
+{
+	conn_handle *conn_res = (conn_handle *) dbh->driver_data;
+	const char *end = sql + sql_len;
+	const char *p;
+	const char *temp_table = NULL;
+	unsigned int set = 0, cleared = 0;
+	int i;
+
+	if ((p = sql_match_keyword(sql, end, "SET")) != NULL) {
+		if (sql_match_keyword(p, end, "ISOLATION") != NULL ||
+				sql_match_keyword(p, end, "TRANSACTION") != NULL) {
+			set = INFORMIX_SESSION_ISOLATION;
+		} else if (sql_match_keyword(p, end, "LOCK") != NULL) {
+			set = INFORMIX_SESSION_LOCK_MODE;
+		} else if (sql_match_keyword(p, end, "PDQPRIORITY") != NULL) {
+			set = INFORMIX_SESSION_PDQPRIORITY;
+		} else if ((p = sql_match_keyword(p, end, "ENVIRONMENT")) != NULL &&
+				sql_match_keyword(p, end, "OPTCOMPIND") != NULL) {
+			set = INFORMIX_SESSION_OPTCOMPIND;
+		}
+	} else if (sql_match_keyword(sql, end, "BEGIN") != NULL) {
+		set = INFORMIX_SESSION_TRANSACTION;
+	} else if ((p = sql_match_keyword(sql, end, "COMMIT")) != NULL ||
+			(p = sql_match_keyword(sql, end, "ROLLBACK")) != NULL) {
+		/* ROLLBACK [WORK] TO SAVEPOINT leaves the transaction open */
+		const char *q = sql_match_keyword(p, end, "WORK");
+		if (sql_match_keyword(q != NULL ? q : p, end, "TO") == NULL) {
+			cleared = INFORMIX_SESSION_TRANSACTION;
+		}
+	} else if ((p = sql_match_keyword(sql, end, "CREATE")) != NULL) {
+		if ((p = sql_match_keyword(p, end, "TEMP")) != NULL &&
+				(p = sql_match_keyword(p, end, "TABLE")) != NULL) {
+			temp_table = p;
+		}
+	} else if (conn_res->reset_on_reuse && sql_match_keyword(sql, end, "SELECT") != NULL) {
+		/* SELECT ... INTO TEMP name */
+		for (p = sql; p + sizeof("INTO TEMP") <= end; p++) {
+			if ((*p == 'I' || *p == 'i') && strncasecmp(p, "INTO", 4) == 0 &&
+					(p == sql || isspace((unsigned char) p[-1]))) {
+				const char *q = sql_match_keyword(p, end, "INTO");
+				if (q != NULL && (q = sql_match_keyword(q, end, "TEMP")) != NULL) {
+					temp_table = q;
+					break;
+				}
+			}
+		}
+	}
+
+	/*
+	* A setting changed through SQL overrides whatever was asked for through
+	* the driver attributes, and leaves its server side value unknown.
+	*/
+	for (i = 0; i < INFORMIX_SETTING_COUNT; i++) {
+		if (set & (1 << i)) {
+			conn_res->setting_wanted[i] = INFORMIX_SETTING_UNSET;
+			conn_res->setting_applied[i] = INFORMIX_SETTING_UNSET;
+			conn_res->setting_pending &= ~(1 << i);
+		}
+	}
+
+	if (conn_res->reset_on_reuse) {
+		conn_res->session_dirty &= ~cleared;
+		if (temp_table != NULL) {
+			session_add_temp_table(conn_res, temp_table, end);
+		}
+		if (set != 0 || temp_table != NULL) {
+			session_mark(conn_res, set TSRMLS_CC);
+		}
+	}
+}
+
+/* note the isolation level in effect, for the reset to return to */
+static void session_capture_isolation(conn_handle *conn_res)
+{
+	int rc = SQLGetConnectAttr((SQLHDBC) conn_res->hdbc, SQL_ATTR_TXN_ISOLATION,
+			(SQLPOINTER) &conn_res->txn_isolation, SQL_IS_INTEGER, NULL);
+	if (rc == SQL_ERROR) {
+		conn_res->txn_isolation = SQL_TXN_READ_COMMITTED;
+	}
+}
+
+/* the statement putting back the isolation level a session started with */
+static const char *session_isolation_sql(SQLINTEGER level)
+{
+	switch (level) {
+		case SQL_TXN_READ_UNCOMMITTED:
+			return "SET ISOLATION TO DIRTY READ";
+		case SQL_TXN_REPEATABLE_READ:
+		case SQL_TXN_SERIALIZABLE:
+			return "SET ISOLATION TO REPEATABLE READ";
+		case SQL_TXN_READ_COMMITTED:
+		default:
+			return "SET ISOLATION TO COMMITTED READ";
+	}
+}
+
+/*
+* Append the statement giving a session setting the requested value, or
+* its session default for INFORMIX_SETTING_UNSET, and a separator.
+*/
+static void session_append_setting(conn_handle *conn_res, smart_str *sql, int setting, long value)
+{
+	switch (setting) {
+		case INFORMIX_SETTING_ISOLATION:
+			switch (value) {
+				case PDO_INFORMIX_ISOLATION_DIRTY_READ:
+					smart_str_appends(sql, "SET ISOLATION TO DIRTY READ");
+					break;
+				case PDO_INFORMIX_ISOLATION_COMMITTED_READ:
+					smart_str_appends(sql, "SET ISOLATION TO COMMITTED READ");
+					break;
+				case PDO_INFORMIX_ISOLATION_LAST_COMMITTED:
+					smart_str_appends(sql, "SET ISOLATION TO COMMITTED READ LAST COMMITTED");
+					break;
+				case PDO_INFORMIX_ISOLATION_CURSOR_STABILITY:
+					smart_str_appends(sql, "SET ISOLATION TO CURSOR STABILITY");
+					break;
+				case PDO_INFORMIX_ISOLATION_REPEATABLE_READ:
+					smart_str_appends(sql, "SET ISOLATION TO REPEATABLE READ");
+					break;
+				default:
+					smart_str_appends(sql, session_isolation_sql(conn_res->txn_isolation));
+					break;
+			}
+			break;
+
+		case INFORMIX_SETTING_LOCK_WAIT:
+			if (value == INFORMIX_SETTING_UNSET || value == 0) {
+				smart_str_appends(sql, "SET LOCK MODE TO NOT WAIT");
+			} else if (value < 0) {
+				smart_str_appends(sql, "SET LOCK MODE TO WAIT");
+			} else {
+				smart_str_appends(sql, "SET LOCK MODE TO WAIT ");
+				smart_str_append_long(sql, value);
+			}
+			break;
+
+		case INFORMIX_SETTING_PDQPRIORITY:
+			if (value == INFORMIX_SETTING_UNSET) {
+				smart_str_appends(sql, "SET PDQPRIORITY DEFAULT");
+			} else {
+				smart_str_appends(sql, "SET PDQPRIORITY ");
+				smart_str_append_long(sql, value);
+			}
+			break;
+
+		case INFORMIX_SETTING_OPTCOMPIND:
+			if (value == INFORMIX_SETTING_UNSET) {
+				smart_str_appends(sql, "SET ENVIRONMENT OPTCOMPIND DEFAULT");
+			} else {
+				smart_str_appends(sql, "SET ENVIRONMENT OPTCOMPIND '");
+				smart_str_append_long(sql, value);
+				smart_str_appendc(sql, '\'');
+			}
+			break;
+	}
+	smart_str_appendc(sql, ';');
+}
+
+/*
+* Record a session setting requested through a driver attribute.  The
+* value is only sent to the server, batched with any other pending
+* setting, when the next statement runs and it differs from what the
+* session is known to have.
+*/
+static int session_want_setting(pdo_dbh_t *dbh, int setting, long value TSRMLS_DC)
+{
+	conn_handle *conn_res = (conn_handle *) dbh->driver_data;
+	int valid;
+
+	switch (setting) {
+		case INFORMIX_SETTING_ISOLATION:
+			valid = value >= PDO_INFORMIX_ISOLATION_DIRTY_READ &&
+				value <= PDO_INFORMIX_ISOLATION_REPEATABLE_READ;
+			break;
+		case INFORMIX_SETTING_PDQPRIORITY:
+			valid = value >= 0 && value <= 100;
+			break;
+		case INFORMIX_SETTING_OPTCOMPIND:
+			valid = value >= 0 && value <= 2;
+			break;
+		default:
+			valid = 1;
+			break;
+	}
+	if (!valid) {
+		RAISE_INFORMIX_DBH_ERROR("HY024", "setAttribute", "Invalid attribute value");
+		return FALSE;
+	}
+
+	conn_res->session_tuned = 1;
+	conn_res->setting_wanted[setting] = value;
+	if (conn_res->setting_applied[setting] != value) {
+		conn_res->setting_pending |= 1 << setting;
+	} else {
+		conn_res->setting_pending &= ~(1 << setting);
+	}
+	/* moving away from the connection's configuration needs undoing later */
+	if (conn_res->reset_on_reuse && conn_res->setting_initial[setting] != value) {
+		session_mark(conn_res, 1 << setting TSRMLS_CC);
+	}
+	return TRUE;
+}
+
+/*
+* Send every pending session setting to the server in a single exchange.
+* Called before the next statement runs on the connection.
+*/
+static int session_apply_settings(pdo_dbh_t *dbh TSRMLS_DC)
+{
+	conn_handle *conn_res = (conn_handle *) dbh->driver_data;
+	smart_str batch = {0};
+	unsigned int pending = conn_res->setting_pending;
+	int i, rc;
+
+	for (i = 0; i < INFORMIX_SETTING_COUNT; i++) {
+		if (pending & (1 << i)) {
+			session_append_setting(conn_res, &batch, i, conn_res->setting_wanted[i]);
+		}
+	}
+	conn_res->setting_pending = 0;
+	if (batch.len == 0) {
+		return TRUE;
+	}
+
+	/* drop the trailing separator */
+	batch.len--;
+	smart_str_0(&batch);
+	rc = informix_exec_direct(dbh, conn_res, batch.c, batch.len TSRMLS_CC);
+	smart_str_free(&batch);
+
+	if (rc == SQL_ERROR) {
+		/* an error while connecting has already closed the connection */
+		if (dbh->driver_data != NULL) {
+			for (i = 0; i < INFORMIX_SETTING_COUNT; i++) {
+				if (pending & (1 << i)) {
+					conn_res->setting_applied[i] = INFORMIX_SETTING_UNSET;
+				}
+			}
+		}
+		return FALSE;
+	}
+	for (i = 0; i < INFORMIX_SETTING_COUNT; i++) {
+		if (pending & (1 << i)) {
+			conn_res->setting_applied[i] = conn_res->setting_wanted[i];
+		}
+	}
+	return TRUE;
+}
+
+/* map a driver attribute onto the session setting it controls */
+static int session_setting_for_attr(long attr)
+{
+	switch (attr) {
+		case PDO_INFORMIX_ATTR_ISOLATION:
+			return INFORMIX_SETTING_ISOLATION;
+		case PDO_INFORMIX_ATTR_LOCK_WAIT:
+			return INFORMIX_SETTING_LOCK_WAIT;
+		case PDO_INFORMIX_ATTR_PDQPRIORITY:
+			return INFORMIX_SETTING_PDQPRIORITY;
+		case PDO_INFORMIX_ATTR_OPTCOMPIND:
+			return INFORMIX_SETTING_OPTCOMPIND;
+	}
+	return -1;
+}
+
+/*
+* Undo the session changes a request made on a persistent connection.  All
+* the restoring statements are sent in a single batch; only if the server
+* rejects the batch (typically a temp table that is already gone) are they
+* replayed one at a time.
+*/
+static void session_reset(conn_handle *conn_res TSRMLS_DC)
+{
+	smart_str batch = {0};
+	unsigned int dirty = conn_res->session_dirty;
+	int i, rc = SQL_SUCCESS;
+
+	if (dirty & INFORMIX_SESSION_TRANSACTION) {
+		if (conn_res->in_begin_work) {
+			conn_res->in_begin_work = 0;
+			rc = informix_exec_direct(NULL, conn_res, "ROLLBACK WORK",
+					sizeof("ROLLBACK WORK") - 1 TSRMLS_CC);
+		} else {
+			rc = SQLEndTran(SQL_HANDLE_DBC, conn_res->hdbc, SQL_ROLLBACK);
+		}
+		if (rc == SQL_ERROR) {
+			/* make the next reuse prove the connection is still usable */
+			conn_res->last_used = 0;
+		}
+		rc = SQL_SUCCESS;
+	}
+	/* the tunable settings go back to what the connection was opened with */
+	for (i = 0; i < INFORMIX_SETTING_COUNT; i++) {
+		if (dirty & (1 << i)) {
+			session_append_setting(conn_res, &batch, i, conn_res->setting_initial[i]);
+		}
+	}
+	if (dirty & INFORMIX_SESSION_TEMP_TABLES) {
+		smart_str_appendl(&batch, conn_res->temp_tables.c, conn_res->temp_tables.len);
+	}
+
+	if (batch.len > 0) {
+		/* drop the trailing separator */
+		batch.len--;
+		smart_str_0(&batch);
+		rc = informix_exec_direct(NULL, conn_res, batch.c, batch.len TSRMLS_CC);
+		if (rc == SQL_ERROR) {
+			char *stmt = batch.c, *sep;
+			do {
+				sep = strchr(stmt, ';');
+				if (sep != NULL) {
+					*sep = '\0';
+				}
+				informix_exec_direct(NULL, conn_res, stmt, SQL_NTS TSRMLS_CC);
+				stmt = sep + 1;
+			} while (sep != NULL);
+		}
+		smart_str_free(&batch);
+	}
+
+	for (i = 0; i < INFORMIX_SETTING_COUNT; i++) {
+		if (dirty & (1 << i)) {
+			conn_res->setting_wanted[i] = conn_res->setting_initial[i];
+			conn_res->setting_applied[i] = (rc == SQL_ERROR) ?
+				INFORMIX_SETTING_UNSET : conn_res->setting_initial[i];
+			conn_res->setting_pending &= ~(1 << i);
+		}
+	}
+	smart_str_free_ex(&conn_res->temp_tables, 1);
+	conn_res->session_dirty = 0;
+}
+
+/* called at request end for every persistent connection the request dirtied */
+void informix_session_reset_all(TSRMLS_D)
+{
+	conn_handle *conn_res;
+
+	while ((conn_res = PDO_INFORMIX_G(dirty_conns)) != NULL) {
+		PDO_INFORMIX_G(dirty_conns) = conn_res->next_dirty;
+		conn_res->next_dirty = NULL;
+		conn_res->session_listed = 0;
+		session_reset(conn_res TSRMLS_CC);
+	}
+}
+
 /*
 *  NB.  The handle closer is used for PDO dtor purposes, but we also use this
 *  for error cleanup if we need to throw an exception while creating the
@@ -193,7 +765,10 @@ static int informix_handle_closer( pdo_dbh_t * dbh TSRMLS_DC)
 	 * validity of each bit as we unwind.
 	 */
 	if (conn_res != NULL) {
-		/* did we get at least as far as creating the environment? */
+		/* make sure the request end does not try to reset this one */
+		session_forget(conn_res TSRMLS_CC);
+
+		/* did we get at least as far as referencing the environment? */
 		if (conn_res->henv != SQL_NULL_HANDLE) {
 			/*
 			* If we have a handle for the connection, we have
@@ -205,15 +780,23 @@ static int informix_handle_closer( pdo_dbh_t * dbh TSRMLS_DC)
 				* There's no point in checking for errors here...
 				* PDO won't process any of the failures even if they happen.
 				*/
-				if (dbh->auto_commit == 0) {
+				if (conn_res->in_begin_work) {
+					informix_exec_direct(NULL, conn_res, "ROLLBACK WORK",
+							sizeof("ROLLBACK WORK") - 1 TSRMLS_CC);
+				} else if (dbh->auto_commit == 0) {
 					SQLEndTran(SQL_HANDLE_DBC, (SQLHDBC) conn_res->hdbc, 
 							SQL_ROLLBACK);
 				}
+				if (conn_res->hstmt_exec != SQL_NULL_HANDLE) {
+					SQLFreeHandle(SQL_HANDLE_STMT, conn_res->hstmt_exec);
+					conn_res->hstmt_exec = SQL_NULL_HANDLE;
+				}
 				SQLDisconnect((SQLHDBC) conn_res->hdbc);
 				SQLFreeHandle(SQL_HANDLE_DBC, conn_res->hdbc);
 			}
-			/* and finally the handle */
-			SQLFreeHandle(SQL_HANDLE_ENV, conn_res->henv);
+			/* and finally drop our reference on the shared environment */
+			informix_env_release();
+			conn_res->henv = SQL_NULL_HANDLE;
 		}
 		/* now free the driver data */
 		pefree(conn_res, dbh->is_persistent);
@@ -233,18 +816,28 @@ static int informix_handle_preparer(
 {
 	conn_handle *conn_res = (conn_handle *)dbh->driver_data;
 
+	/* bring the session settings up to date first */
+	if (conn_res->setting_pending && session_apply_settings(dbh TSRMLS_CC) == FALSE) {
+		return FALSE;
+	}
+
 	/* allocate new driver_data structure */
 	if (dbh_new_stmt_data(dbh, stmt TSRMLS_CC) == TRUE) {
+		int rc;
+
 		/* Allocates the stmt handle */
 		/* Prepares the statement */
 		/* returns the stat_handle back to the calling function */
-		return dbh_prepare_stmt(dbh, stmt, sql, sql_len, driver_options TSRMLS_CC);
+		PDO_INFORMIX_PREPARE_ENTRY(stmt, (char *) sql);
+		rc = dbh_prepare_stmt(dbh, stmt, sql, sql_len, driver_options TSRMLS_CC);
+		PDO_INFORMIX_PREPARE_RETURN(stmt, rc);
+		return rc;
 	}
 	return FALSE;
 }
 
 /* directly execute an SQL statement. */
-static long informix_handle_doer(
+static long dbh_exec_direct(
 	pdo_dbh_t *dbh,
 	const char *sql,
 	long sql_len
@@ -253,19 +846,44 @@ static long informix_handle_doer(
 	conn_handle *conn_res = (conn_handle *) dbh->driver_data;
 	SQLHANDLE hstmt;
 	SQLLEN rowCount;
-	/* get a statement handle */
-	int rc = SQLAllocHandle(SQL_HANDLE_STMT, conn_res->hdbc, &hstmt);
-	check_dbh_error(rc, "SQLAllocHandle");
+	int rc, timed;
+	double start = 0.0, elapsed = 0.0;
 
+	/* bring the session settings up to date first */
+	if (conn_res->setting_pending && session_apply_settings(dbh TSRMLS_CC) == FALSE) {
+		return -1;
+	}
+
+	/* get the connection's exec statement handle */
+	hstmt = informix_exec_handle(dbh, conn_res TSRMLS_CC);
+	if (hstmt == SQL_NULL_HANDLE) {
+		return -1;
+	}
+
+	/* the clock is only read for the statistics and the slow query log */
+	timed = conn_res->collect_stats || INFORMIX_SLOW_QUERY_ENABLED();
+	if (timed) {
+		start = informix_clock();
+	}
 	rc = SQLExecDirect(hstmt, (SQLCHAR *) sql, sql_len);
+	if (timed) {
+		elapsed = informix_clock() - start;
+		PDO_INFORMIX_G(execute_time) += elapsed;
+		PDO_INFORMIX_G(timed_executes)++;
+	}
+	PDO_INFORMIX_G(executes)++;
 	if (rc == SQL_ERROR) {
 		/*
-		* NB...we raise the error before freeing the handle so that
+		* NB...we raise the error before closing the handle so that
 		* we catch the proper error record.
 		*/
 		raise_sql_error(dbh, NULL, hstmt, SQL_HANDLE_STMT,
 			"SQLExecDirect", __FILE__, __LINE__ TSRMLS_CC);
-		SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+		SQLFreeStmt(hstmt, SQL_CLOSE);
+		if (INFORMIX_SLOW_QUERY_ENABLED() &&
+				elapsed * 1000.0 >= PDO_INFORMIX_G(slow_query_threshold)) {
+			informix_slow_query_log(sql, sql_len, NULL, -1, elapsed, 0.0 TSRMLS_CC);
+		}
 
 		/*
 		* Things are a bit overloaded here...we're supposed to return a count
@@ -291,7 +909,7 @@ static long informix_handle_doer(
 			*/
 			raise_sql_error(dbh, NULL, hstmt, SQL_HANDLE_STMT,
 				"SQLRowCount", __FILE__, __LINE__ TSRMLS_CC);
-			SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+			SQLFreeStmt(hstmt, SQL_CLOSE);
 			return -1;
 		}
 		/*
@@ -307,54 +925,138 @@ static long informix_handle_doer(
 
 	/* Set the last serial id inserted */
 	rc = record_last_insert_id(dbh, hstmt TSRMLS_CC);
+	/* close the cursor side of the handle; it is kept for the next exec() */
+	SQLFreeStmt(hstmt, SQL_CLOSE);
 	if( rc == SQL_ERROR ) {
 		return -1;
 	}
-	/* this is a one-shot deal, so make sure we free the statement handle */
-	SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	if (conn_res->reset_on_reuse || conn_res->session_tuned) {
+		informix_session_track(dbh, sql, sql_len TSRMLS_CC);
+	}
+	if (INFORMIX_SLOW_QUERY_ENABLED() &&
+			elapsed * 1000.0 >= PDO_INFORMIX_G(slow_query_threshold)) {
+		informix_slow_query_log(sql, sql_len, NULL, rowCount, elapsed, 0.0 TSRMLS_CC);
+	}
+	conn_res->last_used = time(NULL);
 	return rowCount;
 }
 
+static long informix_handle_doer(
+	pdo_dbh_t *dbh,
+	const char *sql,
+	long sql_len
+	TSRMLS_DC)
+{
+	long rows;
+
+	PDO_INFORMIX_EXEC_ENTRY(dbh, (char *) sql);
+	rows = dbh_exec_direct(dbh, sql, sql_len TSRMLS_CC);
+	PDO_INFORMIX_EXEC_RETURN(dbh, rows, rows >= 0);
+	return rows;
+}
+
+/*
+* Set the CLI autocommit attribute.  The effective state is cached in the
+* connection so that requests for the mode already in force cost nothing.
+*/
+static int informix_set_autocommit(pdo_dbh_t *dbh, SQLUINTEGER mode TSRMLS_DC)
+{
+	conn_handle *conn_res = (conn_handle *) dbh->driver_data;
+	int rc;
+
+	if (conn_res->autocommit == mode) {
+		return TRUE;
+	}
+	rc = SQLSetConnectAttr((SQLHDBC) conn_res->hdbc, SQL_ATTR_AUTOCOMMIT,
+			(SQLPOINTER) mode, SQL_NTS);
+	check_dbh_error(rc, "SQLSetConnectAttr");
+	conn_res->autocommit = mode;
+	return TRUE;
+}
+
 /* start a new transaction */
 static int informix_handle_begin( pdo_dbh_t *dbh TSRMLS_DC)
 {
 	conn_handle *conn_res = (conn_handle *) dbh->driver_data;
-	int rc = SQLSetConnectAttr(conn_res->hdbc, SQL_ATTR_AUTOCOMMIT,
-			(SQLPOINTER) SQL_AUTOCOMMIT_OFF, SQL_NTS);
-	check_dbh_error(rc, "SQLSetConnectAttr");
+
+	/* settings such as the isolation level must be in place before the work starts */
+	if (conn_res->setting_pending && session_apply_settings(dbh TSRMLS_CC) == FALSE) {
+		return FALSE;
+	}
+
+	if (conn_res->begin_work && conn_res->autocommit == SQL_AUTOCOMMIT_ON) {
+		/*
+		* Open an explicit transaction and leave the autocommit attribute
+		* alone; COMMIT WORK or ROLLBACK WORK will end it again.
+		*/
+		if (informix_exec_direct(dbh, conn_res, "BEGIN WORK",
+				sizeof("BEGIN WORK") - 1 TSRMLS_CC) == SQL_ERROR) {
+			return FALSE;
+		}
+		conn_res->in_begin_work = 1;
+	} else if (informix_set_autocommit(dbh, SQL_AUTOCOMMIT_OFF TSRMLS_CC) == FALSE) {
+		return FALSE;
+	}
+	if (conn_res->reset_on_reuse) {
+		session_mark(conn_res, INFORMIX_SESSION_TRANSACTION TSRMLS_CC);
+	}
 	return TRUE;
 }
 
-static int informix_handle_commit(
-	pdo_dbh_t *dbh
-	TSRMLS_DC)
+/* end the current transaction, committing or rolling back its work */
+static int informix_end_transaction(pdo_dbh_t *dbh, SQLSMALLINT completion TSRMLS_DC)
 {
 	conn_handle *conn_res = (conn_handle *)dbh->driver_data;
+	int rc;
+
+	if (conn_res->in_begin_work) {
+		if (completion == SQL_COMMIT) {
+			rc = informix_exec_direct(dbh, conn_res, "COMMIT WORK",
+					sizeof("COMMIT WORK") - 1 TSRMLS_CC);
+		} else {
+			rc = informix_exec_direct(dbh, conn_res, "ROLLBACK WORK",
+					sizeof("ROLLBACK WORK") - 1 TSRMLS_CC);
+		}
+		/* a transaction that failed to end is still open, as PDO also sees it */
+		if (rc == SQL_ERROR) {
+			return FALSE;
+		}
+		conn_res->in_begin_work = 0;
+		conn_res->session_dirty &= ~INFORMIX_SESSION_TRANSACTION;
+		return TRUE;
+	}
 
-	int rc = SQLEndTran(SQL_HANDLE_DBC, conn_res->hdbc, SQL_COMMIT);
+	rc = SQLEndTran(SQL_HANDLE_DBC, conn_res->hdbc, completion);
 	check_dbh_error(rc, "SQLEndTran");
+	conn_res->session_dirty &= ~INFORMIX_SESSION_TRANSACTION;
 	if (dbh->auto_commit != 0) {
-		rc = SQLSetConnectAttr(conn_res->hdbc, SQL_ATTR_AUTOCOMMIT,
-				(SQLPOINTER) SQL_AUTOCOMMIT_ON, SQL_NTS);
-		check_dbh_error(rc, "SQLSetConnectAttr");
+		return informix_set_autocommit(dbh, SQL_AUTOCOMMIT_ON TSRMLS_CC);
 	}
 	return TRUE;
 }
 
+static int informix_handle_commit(
+	pdo_dbh_t *dbh
+	TSRMLS_DC)
+{
+	int rc;
+
+	PDO_INFORMIX_COMMIT_ENTRY(dbh);
+	rc = informix_end_transaction(dbh, SQL_COMMIT TSRMLS_CC);
+	PDO_INFORMIX_COMMIT_RETURN(dbh, rc);
+	return rc;
+}
+
 static int informix_handle_rollback(
 	pdo_dbh_t *dbh
 	TSRMLS_DC)
 {
-	conn_handle *conn_res = (conn_handle *)dbh->driver_data;
+	int rc;
 
-	int rc = SQLEndTran(SQL_HANDLE_DBC, conn_res->hdbc, SQL_ROLLBACK);
-	check_dbh_error(rc, "SQLEndTran");
-	if (dbh->auto_commit != 0) {
-		rc = SQLSetConnectAttr(conn_res->hdbc, SQL_ATTR_AUTOCOMMIT,
-				(SQLPOINTER) SQL_AUTOCOMMIT_ON, SQL_NTS);
-		check_dbh_error(rc, "SQLSetConnectAttr");
-	}
-	return TRUE;
+	PDO_INFORMIX_ROLLBACK_ENTRY(dbh);
+	rc = informix_end_transaction(dbh, SQL_ROLLBACK TSRMLS_CC);
+	PDO_INFORMIX_ROLLBACK_RETURN(dbh, rc);
+	return rc;
 }
 
 /* Set the driver attributes. We allow the setting of autocommit */
@@ -368,18 +1070,111 @@ static int informix_handle_set_attribute(
 	int rc = 0;
 
 	switch (attr) {
+		case PDO_INFORMIX_ATTR_ISOLATION:
+		case PDO_INFORMIX_ATTR_LOCK_WAIT:
+		case PDO_INFORMIX_ATTR_PDQPRIORITY:
+		case PDO_INFORMIX_ATTR_OPTCOMPIND:
+			convert_to_long(return_value);
+			return session_want_setting(dbh, session_setting_for_attr(attr),
+					Z_LVAL_P(return_value) TSRMLS_CC);
+
+		case PDO_INFORMIX_ATTR_LIVENESS_INTERVAL:
+			convert_to_long(return_value);
+			conn_res->liveness_interval = Z_LVAL_P(return_value);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_RESET_ON_REUSE:
+			/* only persistent connections outlive the request */
+			if (dbh->is_persistent && zend_is_true(return_value)) {
+				if (!conn_res->reset_on_reuse) {
+					session_capture_isolation(conn_res);
+				}
+				conn_res->reset_on_reuse = 1;
+			} else {
+				conn_res->reset_on_reuse = 0;
+			}
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_BEGIN_WORK:
+			conn_res->begin_work = zend_is_true(return_value);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_STATS:
+			conn_res->collect_stats = zend_is_true(return_value);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_LAZY_FETCH:
+			conn_res->lazy_fetch = zend_is_true(return_value);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_LOB_CHUNK_SIZE:
+			convert_to_long(return_value);
+			if (Z_LVAL_P(return_value) <= 0) {
+				RAISE_INFORMIX_DBH_ERROR("HY024", "setAttribute",
+					"The LOB chunk size must be positive");
+				return FALSE;
+			}
+			conn_res->lob_chunk_size = Z_LVAL_P(return_value);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_TEMPORAL_MODE:
+			convert_to_long(return_value);
+			if (!INFORMIX_TEMPORAL_MODE_VALID(Z_LVAL_P(return_value))) {
+				RAISE_INFORMIX_DBH_ERROR("HY024", "setAttribute",
+					"Invalid temporal mode");
+				return FALSE;
+			}
+			conn_res->temporal_mode = (int) Z_LVAL_P(return_value);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_MAX_BIND_SIZE:
+			convert_to_long(return_value);
+			if (Z_LVAL_P(return_value) < 0) {
+				RAISE_INFORMIX_DBH_ERROR("HY024", "setAttribute",
+					"The maximum bind size cannot be negative");
+				return FALSE;
+			}
+			conn_res->max_bind_size = Z_LVAL_P(return_value);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_SMART_LOB:
+			/* fixed when the connection is made; PDO repeats the option here */
+			if ((zend_is_true(return_value) ? 1 : 0) != conn_res->smart_lob) {
+				RAISE_INFORMIX_DBH_ERROR("HY011", "setAttribute",
+					"The smart LOB mode can only be chosen when connecting");
+				return FALSE;
+			}
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_COMPLEX_TYPES:
+			if ((zend_is_true(return_value) ? 1 : 0) != conn_res->complex_types) {
+				RAISE_INFORMIX_DBH_ERROR("HY011", "setAttribute",
+					"The complex types mode can only be chosen when connecting");
+				return FALSE;
+			}
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_QUERY_TIMEOUT:
+			convert_to_long(return_value);
+			if (Z_LVAL_P(return_value) < 0) {
+				RAISE_INFORMIX_DBH_ERROR("HY024", "setAttribute",
+					"The query timeout cannot be negative");
+				return FALSE;
+			}
+			conn_res->query_timeout = Z_LVAL_P(return_value);
+			/* PDO::exec() runs on the connection's own statement handle */
+			if (conn_res->hstmt_exec != SQL_NULL_HANDLE) {
+				rc = SQLSetStmtAttr(conn_res->hstmt_exec, SQL_ATTR_QUERY_TIMEOUT,
+						(SQLPOINTER) conn_res->query_timeout, 0);
+				check_dbh_error(rc, "SQLSetStmtAttr");
+			}
+			return TRUE;
+
 		case PDO_ATTR_AUTOCOMMIT:
 			if (dbh->auto_commit != Z_LVAL_P(return_value)) {
 				dbh->auto_commit = Z_LVAL_P(return_value);
-				if (dbh->auto_commit == TRUE) {
-					rc = SQLSetConnectAttr((SQLHDBC) conn_res->hdbc, SQL_ATTR_AUTOCOMMIT,
-						(SQLPOINTER) SQL_AUTOCOMMIT_ON, SQL_NTS);
-					check_dbh_error(rc, "SQLSetConnectAttr");
-				} else {
-					rc = SQLSetConnectAttr((SQLHDBC) conn_res->hdbc, SQL_ATTR_AUTOCOMMIT,
-						(SQLPOINTER) SQL_AUTOCOMMIT_OFF, SQL_NTS);
-					check_dbh_error(rc, "SQLSetConnectAttr");
-				}
+				return informix_set_autocommit(dbh, dbh->auto_commit == TRUE ?
+						SQL_AUTOCOMMIT_ON : SQL_AUTOCOMMIT_OFF TSRMLS_CC);
 			}
 			return TRUE;
 			break;
@@ -432,7 +1227,77 @@ static int informix_handle_fetch_error(
 	return TRUE;
 }
 
-/* quotes an SQL statement */
+/*
+* Escape letter for every byte that needs a backslash inside a quoted
+* literal, 0 for bytes that are copied through unchanged.
+*/
+static const char informix_quote_escape[256] = {
+	'0', 0, 0, 0, 0, 0, 0, 0, 0, 0, 'n', 0, 0, 'r', 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 'Z', 0, 0, 0, 0, 0,
+	0, 0, '"', 0, 0, 0, 0, '\'', 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/*
+* Return the first byte in [p, end) that needs escaping, or end.  With SSE2
+* available, sixteen bytes are checked at a time so that long runs of plain
+* text are skipped without looking at each byte.
+*/
+static const char *quote_scan(const char *p, const char *end)
+{
+#ifdef __SSE2__
+	const __m128i nul = _mm_setzero_si128();
+	const __m128i nl = _mm_set1_epi8('\n');
+	const __m128i cr = _mm_set1_epi8('\r');
+	const __m128i sub = _mm_set1_epi8('\x1a');
+	const __m128i squote = _mm_set1_epi8('\'');
+	const __m128i dquote = _mm_set1_epi8('\"');
+	const __m128i bslash = _mm_set1_epi8('\\');
+
+	while (end - p >= 16) {
+		__m128i chunk = _mm_loadu_si128((const __m128i *) p);
+		__m128i hit = _mm_or_si128(
+			_mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, nul), _mm_cmpeq_epi8(chunk, nl)),
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, sub))),
+			_mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, squote), _mm_cmpeq_epi8(chunk, dquote)),
+				_mm_cmpeq_epi8(chunk, bslash)));
+		int mask = _mm_movemask_epi8(hit);
+		if (mask != 0) {
+			int n = 0;
+			while (!(mask & 1)) {
+				mask >>= 1;
+				n++;
+			}
+			return p + n;
+		}
+		p += 16;
+	}
+#endif
+	while (p < end && !informix_quote_escape[(unsigned char) *p]) {
+		p++;
+	}
+	return p;
+}
+
+/*
+* Quote a string for inclusion in SQL text.  The escapes are counted first
+* so that the result is written in one go into a buffer of exactly the
+* right size.
+*/
 static int informix_handle_quoter(
 	pdo_dbh_t *dbh,
 	const char *unq,
@@ -442,65 +1307,43 @@ static int informix_handle_quoter(
 	enum pdo_param_type paramtype
 	TSRMLS_DC)
 {
+	const char *p, *run, *end;
 	char *sql;
-	int new_length, i, j;
+	size_t escapes = 0, len;
 
 	if(!unq)  {
 		return FALSE;
 	}
 
-	/* allocate twice the source length first (worst case) */
-	sql = (char*)emalloc(((unq_len*2)+3)*sizeof(char));
-
-	/* set the first quote */
-	sql[0] = '\'';
+	end = unq + unq_len;
+	for (p = quote_scan(unq, end); p < end; p = quote_scan(p + 1, end)) {
+		escapes++;
+	}
 
-	j = 1;
-	for (i = 0; i < unq_len; i++) {
-		switch (unq[i]) {
-			case '\n':
-				sql[j++] = '\\';
-				sql[j++] = 'n';
-				break;
-			case '\r':
-				sql[j++] = '\\';
-				sql[j++] = 'r';
-				break;
-			case '\x1a':
-				sql[j++] = '\\';
-				sql[j++] = 'Z';
-				break;
-			case '\0':
-				sql[j++] = '\\';
-				sql[j++] = '0';
-				break;
-			case '\'':
-				sql[j++] = '\\';
-				sql[j++] = '\'';
-				break;
-			case '\"':
-				sql[j++] = '\\';
-				sql[j++] = '\"';
-				break;
-			case '\\':
-				sql[j++] = '\\';
-				sql[j++] = '\\';
-				break;
-			default:
-				sql[j++] = unq[i];
-				break;
+	/*
+	* One extra byte per escape and both quotes, counted in size_t so that
+	* it cannot wrap; the result has to fit PDO's int length.
+	*/
+	len = (size_t) unq_len + escapes;
+	if (len > (size_t) INT_MAX - 2) {
+		return FALSE;
+	}
+	*q_len = (int) len + 2;
+	sql = *q = (char *) safe_emalloc(1, *q_len, 1);
+
+	*sql++ = '\'';
+	for (run = unq; run < end; run = p + 1) {
+		p = quote_scan(run, end);
+		memcpy(sql, run, p - run);
+		sql += p - run;
+		if (p == end) {
+			break;
 		}
+		*sql++ = '\\';
+		*sql++ = informix_quote_escape[(unsigned char) *p];
 	}
-
-	/* set the last quote and null terminating character */
-	sql[j++] = '\'';
-	sql[j++] = '\0';
-
-	/* copy over final string and free the memory used */
-	*q = (char*)emalloc(((unq_len*2)+3)*sizeof(char));
-	strcpy(*q, sql);
-	*q_len = strlen(sql);
-	efree(sql);
+	*sql++ = '\'';
+	*sql = '\0';
 
 	return TRUE;
 }
@@ -536,11 +1379,73 @@ static int informix_handle_get_attribute(
 			ZVAL_STRING(return_value, value, 1);
 			return TRUE;
 
+		case PDO_INFORMIX_ATTR_LIVENESS_INTERVAL:
+			ZVAL_LONG(return_value, conn_res->liveness_interval);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_RESET_ON_REUSE:
+			ZVAL_BOOL(return_value, conn_res->reset_on_reuse);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_BEGIN_WORK:
+			ZVAL_BOOL(return_value, conn_res->begin_work);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_STATS:
+			ZVAL_BOOL(return_value, conn_res->collect_stats);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_LAZY_FETCH:
+			ZVAL_BOOL(return_value, conn_res->lazy_fetch);
+			return TRUE;
 
+		case PDO_INFORMIX_ATTR_LOB_CHUNK_SIZE:
+			ZVAL_LONG(return_value, conn_res->lob_chunk_size);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_QUERY_TIMEOUT:
+			ZVAL_LONG(return_value, conn_res->query_timeout);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_TEMPORAL_MODE:
+			ZVAL_LONG(return_value, conn_res->temporal_mode);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_MAX_BIND_SIZE:
+			ZVAL_LONG(return_value, conn_res->max_bind_size);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_SMART_LOB:
+			ZVAL_BOOL(return_value, conn_res->smart_lob);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_COMPLEX_TYPES:
+			ZVAL_BOOL(return_value, conn_res->complex_types);
+			return TRUE;
+
+		case PDO_INFORMIX_ATTR_ISOLATION:
+		case PDO_INFORMIX_ATTR_LOCK_WAIT:
+		case PDO_INFORMIX_ATTR_PDQPRIORITY:
+		case PDO_INFORMIX_ATTR_OPTCOMPIND:
+		{
+			long value = conn_res->setting_wanted[session_setting_for_attr(attr)];
+			if (value == INFORMIX_SETTING_UNSET) {
+				ZVAL_NULL(return_value);
+			} else {
+				ZVAL_LONG(return_value, value);
+			}
+			return TRUE;
+		}
 	}
 	return FALSE;
 }
 
+/*
+* Called by PDO each time a persistent connection is handed out again.  A
+* dead connection reported by the CLI fails straight away; otherwise the
+* server is only probed once the connection has been idle for longer than
+* the configured liveness interval.
+*/
 static int informix_handle_check_liveness(
 		pdo_dbh_t *dbh
 		TSRMLS_DC)
@@ -548,22 +1453,328 @@ static int informix_handle_check_liveness(
 	int rc = SQL_ERROR;
 	conn_handle *conn_res = (conn_handle *) dbh->driver_data;
 	SQLHANDLE hstmt;
-	check_allocation(hstmt, "informix_handle_check_liveness", "Unable to allocate statement handle");
+	SQLINTEGER dead = 0;
+	time_t now;
+
+	/* this is answered by the client library, no round trip involved */
+	rc = SQLGetConnectAttr(conn_res->hdbc, SQL_ATTR_CONNECTION_DEAD,
+			(SQLPOINTER) &dead, SQL_IS_INTEGER, NULL);
+	if (rc != SQL_ERROR && dead == SQL_CD_TRUE) {
+		return FAILURE;
+	}
+
+	/*
+	* A connection handed out again within the request it was changed in
+	* gets its session put back now rather than at the request end, but
+	* only if no other object still holds it; a handle shared with a live
+	* object is left for the request end.
+	*/
+	if (conn_res->session_listed && dbh->refcount == 1) {
+		session_unlink(conn_res TSRMLS_CC);
+		session_reset(conn_res TSRMLS_CC);
+	}
+
+	/* recently used connections are trusted without asking the server */
+	now = time(NULL);
+	if (rc != SQL_ERROR && conn_res->liveness_interval != 0) {
+		if (conn_res->liveness_interval < 0 ||
+				now - conn_res->last_used < conn_res->liveness_interval) {
+			PDO_INFORMIX_G(connections_reused)++;
+			return SUCCESS;
+		}
+	}
 
 	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn_res->hdbc, &hstmt);
-	if(rc != SQL_SUCCESS) { 
-		efree(hstmt);
+	if (rc != SQL_SUCCESS) {
 		return FAILURE;
 	}
+	PDO_INFORMIX_G(liveness_probes)++;
 
 	rc = SQLPrepare(hstmt, "SELECT today FROM systables WHERE tabid = 1", SQL_NTS);
 	SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
-	if(rc != SQL_SUCCESS) {
+	if (rc != SQL_SUCCESS) {
 		return FAILURE;
 	}
+	conn_res->last_used = now;
+	PDO_INFORMIX_G(connections_reused)++;
 	/* return the state from the query */
 	return SUCCESS;
 }
+/*
+* Savepoint names go straight into the SQL text, so only plain identifiers
+* are accepted: a letter or underscore followed by letters, digits,
+* underscores or dollar signs.
+*/
+static int savepoint_name_valid(const char *name, int name_len)
+{
+	int i;
+
+	if (name_len <= 0 || name_len > 128) {
+		return FALSE;
+	}
+	if (!isalpha((unsigned char) name[0]) && name[0] != '_') {
+		return FALSE;
+	}
+	for (i = 1; i < name_len; i++) {
+		if (!isalnum((unsigned char) name[i]) && name[i] != '_' && name[i] != '$') {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/*
+* Common body of the savepoint methods: validate the name and run
+* "<verb> <name>" on the connection.
+*/
+static void informix_savepoint_exec(INTERNAL_FUNCTION_PARAMETERS, const char *verb, char *tag)
+{
+	pdo_dbh_t *dbh;
+	conn_handle *conn_res;
+	char *name, *sql;
+	int name_len, sql_len, rc;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s", &name, &name_len) == FAILURE) {
+		RETURN_FALSE;
+	}
+
+	dbh = zend_object_store_get_object(getThis() TSRMLS_CC);
+	conn_res = (conn_handle *) dbh->driver_data;
+	if (conn_res == NULL) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "The PDO object is not connected");
+		RETURN_FALSE;
+	}
+	strcpy(dbh->error_code, PDO_ERR_NONE);
+
+	if (!savepoint_name_valid(name, name_len)) {
+		RAISE_INFORMIX_DBH_ERROR("42602", tag, "Invalid savepoint name");
+		pdo_handle_error(dbh, NULL TSRMLS_CC);
+		RETURN_FALSE;
+	}
+
+	/* bring the session settings up to date first */
+	if (conn_res->setting_pending && session_apply_settings(dbh TSRMLS_CC) == FALSE) {
+		pdo_handle_error(dbh, NULL TSRMLS_CC);
+		RETURN_FALSE;
+	}
+
+	sql_len = spprintf(&sql, 0, "%s %s", verb, name);
+	rc = informix_exec_direct(dbh, conn_res, sql, sql_len TSRMLS_CC);
+	efree(sql);
+	if (rc == SQL_ERROR) {
+		pdo_handle_error(dbh, NULL TSRMLS_CC);
+		RETURN_FALSE;
+	}
+	RETURN_TRUE;
+}
+
+/* {{{ proto bool PDO::informixSavepoint(string name)
+   Create a savepoint in the current transaction */
+static PHP_METHOD(PDO_INFORMIX, informixSavepoint)
+{
+	informix_savepoint_exec(INTERNAL_FUNCTION_PARAM_PASSTHRU,
+			"SAVEPOINT", "informixSavepoint");
+}
+/* }}} */
+
+/* {{{ proto bool PDO::informixReleaseSavepoint(string name)
+   Release a savepoint, keeping the work done since it was set */
+static PHP_METHOD(PDO_INFORMIX, informixReleaseSavepoint)
+{
+	informix_savepoint_exec(INTERNAL_FUNCTION_PARAM_PASSTHRU,
+			"RELEASE SAVEPOINT", "informixReleaseSavepoint");
+}
+/* }}} */
+
+/* {{{ proto bool PDO::informixRollbackSavepoint(string name)
+   Undo the work done since a savepoint, leaving the transaction open */
+static PHP_METHOD(PDO_INFORMIX, informixRollbackSavepoint)
+{
+	informix_savepoint_exec(INTERNAL_FUNCTION_PARAM_PASSTHRU,
+			"ROLLBACK WORK TO SAVEPOINT", "informixRollbackSavepoint");
+}
+/* }}} */
+
+/* row count of the current result of a batch, 0 where none applies */
+static SQLLEN batch_row_count(SQLHANDLE hstmt, int rc)
+{
+	SQLLEN row_count = 0;
+
+	if (rc == SQL_NO_DATA || SQLRowCount(hstmt, &row_count) == SQL_ERROR || row_count < 0) {
+		return 0;
+	}
+	return row_count;
+}
+
+/* {{{ proto array PDO::informixExecBatch(array statements)
+   Run a list of statements in a single exchange with the server and return
+   the number of rows each one affected.  Execution stops at the first
+   failing statement, in which case FALSE is returned and the error is
+   reported like any other PDO error, its message naming the position of
+   the statement in the array (counting from 0).  FALSE is also returned
+   if the server answers for fewer statements than were sent. */
+static PHP_METHOD(PDO_INFORMIX, informixExecBatch)
+{
+	pdo_dbh_t *dbh;
+	conn_handle *conn_res;
+	zval *statements, **entry;
+	HashPosition pos;
+	SQLHANDLE hstmt;
+	smart_str batch = {0};
+	int count = 0, done = 0, rc, timed;
+	double start = 0.0;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "a", &statements) == FAILURE) {
+		RETURN_FALSE;
+	}
+
+	dbh = zend_object_store_get_object(getThis() TSRMLS_CC);
+	conn_res = (conn_handle *) dbh->driver_data;
+	if (conn_res == NULL) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING, "The PDO object is not connected");
+		RETURN_FALSE;
+	}
+	strcpy(dbh->error_code, PDO_ERR_NONE);
+
+	/*
+	* Join the statements into one ';' separated text.  Separators the
+	* caller left at the end of a statement are dropped, so that each entry
+	* yields exactly one result, and each separator starts on a new line so
+	* that a statement ending in a -- comment cannot swallow the next one.
+	*/
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(statements), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL_P(statements), (void **) &entry, &pos) == SUCCESS) {
+		zval tmp = **entry;
+		int len;
+
+		zval_copy_ctor(&tmp);
+		convert_to_string(&tmp);
+		len = Z_STRLEN(tmp);
+		while (len > 0 && (Z_STRVAL(tmp)[len - 1] == ';' ||
+				isspace((unsigned char) Z_STRVAL(tmp)[len - 1]))) {
+			len--;
+		}
+		if (len == 0) {
+			zval_dtor(&tmp);
+			smart_str_free(&batch);
+			RAISE_INFORMIX_DBH_ERROR("HY090", "informixExecBatch", "Empty statement in batch");
+			pdo_handle_error(dbh, NULL TSRMLS_CC);
+			RETURN_FALSE;
+		}
+		if (count > 0) {
+			smart_str_appendl(&batch, "\n;", 2);
+		}
+		smart_str_appendl(&batch, Z_STRVAL(tmp), len);
+		zval_dtor(&tmp);
+		count++;
+		zend_hash_move_forward_ex(Z_ARRVAL_P(statements), &pos);
+	}
+
+	array_init(return_value);
+	if (count == 0) {
+		return;
+	}
+	smart_str_0(&batch);
+
+	if (conn_res->setting_pending && session_apply_settings(dbh TSRMLS_CC) == FALSE) {
+		smart_str_free(&batch);
+		zval_dtor(return_value);
+		pdo_handle_error(dbh, NULL TSRMLS_CC);
+		RETURN_FALSE;
+	}
+	hstmt = informix_exec_handle(dbh, conn_res TSRMLS_CC);
+	if (hstmt == SQL_NULL_HANDLE) {
+		smart_str_free(&batch);
+		zval_dtor(return_value);
+		pdo_handle_error(dbh, NULL TSRMLS_CC);
+		RETURN_FALSE;
+	}
+
+	/* one result per statement; SQLMoreResults moves on to the next one */
+	timed = conn_res->collect_stats || INFORMIX_SLOW_QUERY_ENABLED();
+	if (timed) {
+		start = informix_clock();
+	}
+	rc = SQLExecDirect(hstmt, (SQLCHAR *) batch.c, batch.len);
+	while (rc != SQL_ERROR) {
+		add_next_index_long(return_value, (long) batch_row_count(hstmt, rc));
+		if (++done == count) {
+			break;
+		}
+		rc = SQLMoreResults(hstmt);
+		if (rc == SQL_NO_DATA) {
+			break;
+		}
+	}
+	if (rc == SQL_ERROR) {
+		char msg[SQL_MAX_MESSAGE_LENGTH + 1];
+
+		/* raise the error before closing the handle to get the right record */
+		raise_sql_error(dbh, NULL, hstmt, SQL_HANDLE_STMT,
+			"SQLExecDirect", __FILE__, __LINE__ TSRMLS_CC);
+		/* the statements in front of the failing one have been run */
+		snprintf(msg, sizeof(msg), "Statement %d of the batch: %s", done,
+			conn_res->error_data.err_msg);
+		strcpy(conn_res->error_data.err_msg, msg);
+	} else if (done < count) {
+		char msg[SQL_MAX_MESSAGE_LENGTH + 1];
+
+		/* the server saw fewer statements than were sent */
+		snprintf(msg, sizeof(msg), "The server returned results for %d of the %d statements in the batch",
+			done, count);
+		RAISE_INFORMIX_DBH_ERROR("HY000", "informixExecBatch", msg);
+		rc = SQL_ERROR;
+	} else {
+		record_last_insert_id(dbh, hstmt TSRMLS_CC);
+	}
+	SQLFreeStmt(hstmt, SQL_CLOSE);
+	if (timed) {
+		PDO_INFORMIX_G(execute_time) += informix_clock() - start;
+		PDO_INFORMIX_G(timed_executes) += done;
+	}
+	PDO_INFORMIX_G(executes) += done;
+
+	/* keep the session tracking up to date for what did run */
+	if (conn_res->reset_on_reuse || conn_res->session_tuned) {
+		zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(statements), &pos);
+		while (done-- > 0 &&
+				zend_hash_get_current_data_ex(Z_ARRVAL_P(statements), (void **) &entry, &pos) == SUCCESS) {
+			if (Z_TYPE_PP(entry) == IS_STRING) {
+				informix_session_track(dbh, Z_STRVAL_PP(entry), Z_STRLEN_PP(entry) TSRMLS_CC);
+			}
+			zend_hash_move_forward_ex(Z_ARRVAL_P(statements), &pos);
+		}
+	}
+	smart_str_free(&batch);
+
+	if (rc == SQL_ERROR) {
+		zval_dtor(return_value);
+		pdo_handle_error(dbh, NULL TSRMLS_CC);
+		RETURN_FALSE;
+	}
+	conn_res->last_used = time(NULL);
+}
+/* }}} */
+
+static zend_function_entry informix_dbh_functions[] = {
+	PHP_ME(PDO_INFORMIX, informixSavepoint, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(PDO_INFORMIX, informixReleaseSavepoint, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(PDO_INFORMIX, informixRollbackSavepoint, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(PDO_INFORMIX, informixExecBatch, NULL, ZEND_ACC_PUBLIC)
+	{NULL, NULL, NULL}
+};
+
+/* the methods the driver adds to the PDO and PDOStatement classes */
+static zend_function_entry *informix_get_driver_methods(pdo_dbh_t *dbh, int kind TSRMLS_DC)
+{
+	switch (kind) {
+		case PDO_DBH_DRIVER_METHOD_KIND_DBH:
+			return informix_dbh_functions;
+		default:
+			return NULL;
+	}
+}
+
 static struct pdo_dbh_methods informix_dbh_methods = {
 	informix_handle_closer,
 	informix_handle_preparer,
@@ -577,7 +1788,7 @@ static struct pdo_dbh_methods informix_dbh_methods = {
 	informix_handle_fetch_error,
 	informix_handle_get_attribute,
 	informix_handle_check_liveness,	/* check_liveness  */
-	NULL				/* get_driver_methods */
+	informix_get_driver_methods	/* get_driver_methods */
 };
 
 /* handle the business of creating a connection. */
@@ -587,6 +1798,7 @@ static int dbh_connect(pdo_dbh_t *dbh, zval *driver_options TSRMLS_DC)
 	int dsn_length = 0;
 	char *new_dsn = NULL;
 	SQLSMALLINT d_length = 0, u_length = 0, p_length = 0;
+	int i;
 	/*
 	* Allocate our driver data control block.  If this is a persistent
 	* connection, we need to allocate this from persistent storage.
@@ -596,15 +1808,20 @@ static int dbh_connect(pdo_dbh_t *dbh, zval *driver_options TSRMLS_DC)
 
 	/* clear, and hook up to the PDO data structure. */
 	memset((void *) conn_res, '\0', sizeof(conn_handle));
+	for (i = 0; i < INFORMIX_SETTING_COUNT; i++) {
+		conn_res->setting_initial[i] = INFORMIX_SETTING_UNSET;
+		conn_res->setting_wanted[i] = INFORMIX_SETTING_UNSET;
+		conn_res->setting_applied[i] = INFORMIX_SETTING_UNSET;
+	}
 	dbh->driver_data = conn_res;
 
-	/* we need an environment to use for a base */
-	rc = SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &conn_res->henv);
-	check_dbh_error(rc, "SQLAllocHandle");
-	/* and we're using the OBDC version 3 style interface */
-	rc = SQLSetEnvAttr((SQLHENV)conn_res->henv, SQL_ATTR_ODBC_VERSION,
-			(void *) SQL_OV_ODBC3, 0);
-	check_dbh_error(rc, "SQLSetEnvAttr");
+	/* all connections hang off the environment created at module startup */
+	conn_res->henv = informix_env_acquire();
+	if (conn_res->henv == SQL_NULL_HANDLE) {
+		RAISE_INFORMIX_DBH_ERROR("HY000", "SQLAllocHandle",
+			"Unable to allocate the CLI environment");
+		return FALSE;
+	}
 
 	/* now an actual connection handle */
 	rc = SQLAllocHandle(SQL_HANDLE_DBC, conn_res->henv, &(conn_res->hdbc));
@@ -676,25 +1893,118 @@ static int dbh_connect(pdo_dbh_t *dbh, zval *driver_options TSRMLS_DC)
 	}
 
 	/*
-	 * Set NeedODBCTypesOnly=1 because we dont support
-	 * Smart Large Objects in PDO yet
+	 * By default BLOB and CLOB are reported with the ODBC types and their
+	 * contents transferred whole, and collections and ROW values as plain
+	 * text (NeedODBCTypesOnly=1).  In smart LOB mode queries fetch BLOB and
+	 * CLOB as LO pointers, which the statement turns into seekable streams
+	 * over the ifx_lo_* functions; automatic LO transfer is only turned off
+	 * on those statements (see dbh_prepare_stmt), so that strings and
+	 * streams bound to BLOB and CLOB parameters still go across whole.  In
+	 * complex types mode the native types are reported, so the statement
+	 * knows which text to decode into arrays.  The settings are made
+	 * explicitly either way, so that they do not depend on the DSN.
 	 */
+	conn_res->smart_lob = pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_SMART_LOB, 0 TSRMLS_CC) ? 1 : 0;
+	conn_res->complex_types = pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_COMPLEX_TYPES, 0 TSRMLS_CC) ? 1 : 0;
 	rc = SQLSetConnectAttr((SQLHDBC) conn_res->hdbc, SQL_INFX_ATTR_LO_AUTOMATIC,
 			(SQLPOINTER) SQL_TRUE, SQL_NTS);
 	check_dbh_error(rc, "SQLSetConnectAttr");
 	rc = SQLSetConnectAttr((SQLHDBC)conn_res->hdbc, SQL_INFX_ATTR_ODBC_TYPES_ONLY,
-			(SQLPOINTER) SQL_TRUE, SQL_NTS);
+			(SQLPOINTER) (conn_res->smart_lob || conn_res->complex_types ? SQL_FALSE : SQL_TRUE),
+			SQL_NTS);
 	check_dbh_error(rc, "SQLSetConnectAttr");
+	if (conn_res->smart_lob) {
+		rc = SQLGetInfo((SQLHDBC) conn_res->hdbc, SQL_INFX_LO_PTR_LENGTH,
+				&conn_res->lo_ptr_length, sizeof(conn_res->lo_ptr_length), NULL);
+		check_dbh_error(rc, "SQLGetInfo");
+	}
+	/* what SQLGetData allows decides how unbound columns may be read */
+	rc = SQLGetInfo((SQLHDBC) conn_res->hdbc, SQL_GETDATA_EXTENSIONS,
+			&conn_res->getdata_ext, sizeof(conn_res->getdata_ext), NULL);
+	if (rc == SQL_ERROR) {
+		conn_res->getdata_ext = 0;
+	}
 
-	/* if we're in auto commit mode, set the connection attribute. */
-	if (dbh->auto_commit != 0) {
-		rc = SQLSetConnectAttr((SQLHDBC) conn_res->hdbc, SQL_ATTR_AUTOCOMMIT,
-				(SQLPOINTER) SQL_AUTOCOMMIT_ON, SQL_NTS);
-		check_dbh_error(rc, "SQLSetConnectAttr");
-	} else {
-		rc = SQLSetConnectAttr((SQLHDBC) conn_res->hdbc, SQL_ATTR_AUTOCOMMIT,
-				(SQLPOINTER) SQL_AUTOCOMMIT_OFF, SQL_NTS);
-		check_dbh_error(rc, "SQLSetConnectAttr");
+	/*
+	* New connections start out in autocommit mode, so the attribute only
+	* needs setting if PDO asked for manual commit.
+	*/
+	conn_res->autocommit = SQL_AUTOCOMMIT_ON;
+	if (informix_set_autocommit(dbh, dbh->auto_commit != 0 ?
+			SQL_AUTOCOMMIT_ON : SQL_AUTOCOMMIT_OFF TSRMLS_CC) == FALSE) {
+		return FALSE;
+	}
+	conn_res->begin_work = pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_BEGIN_WORK, 0 TSRMLS_CC) ? 1 : 0;
+	conn_res->collect_stats = pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_STATS, 0 TSRMLS_CC) ? 1 : 0;
+	conn_res->lazy_fetch = pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_LAZY_FETCH, 0 TSRMLS_CC) ? 1 : 0;
+	conn_res->temporal_mode = (int) pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_TEMPORAL_MODE, PDO_INFORMIX_TEMPORAL_STRING TSRMLS_CC);
+	if (!INFORMIX_TEMPORAL_MODE_VALID(conn_res->temporal_mode)) {
+		RAISE_INFORMIX_DBH_ERROR("HY024", "dbh_connect", "Invalid temporal mode");
+		return FALSE;
+	}
+
+	/* php.ini supplies the defaults for the tunables */
+	conn_res->lob_chunk_size = pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_LOB_CHUNK_SIZE, PDO_INFORMIX_G(lob_chunk_size) TSRMLS_CC);
+	if (conn_res->lob_chunk_size <= 0) {
+		conn_res->lob_chunk_size = LOB_BUFFER_SIZE;
+	}
+	conn_res->query_timeout = pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_QUERY_TIMEOUT, PDO_INFORMIX_G(query_timeout) TSRMLS_CC);
+	if (conn_res->query_timeout < 0) {
+		conn_res->query_timeout = 0;
+	}
+	conn_res->max_bind_size = pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_MAX_BIND_SIZE, PDO_INFORMIX_G(max_bind_size) TSRMLS_CC);
+	if (conn_res->max_bind_size < 0) {
+		conn_res->max_bind_size = 0;
+	}
+
+	/* how long a persistent connection may idle before reuse probes the server */
+	conn_res->liveness_interval = pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_LIVENESS_INTERVAL, PDO_INFORMIX_G(liveness_check_interval) TSRMLS_CC);
+	conn_res->last_used = time(NULL);
+
+	/*
+	* With reset on reuse, note the isolation level the session starts
+	* with so the request end can put it back.
+	*/
+	if (dbh->is_persistent && pdo_attr_lval(driver_options,
+			PDO_INFORMIX_ATTR_RESET_ON_REUSE, 0 TSRMLS_CC)) {
+		conn_res->reset_on_reuse = 1;
+		session_capture_isolation(conn_res);
+	}
+
+	/*
+	* Session tuning requested as driver options is sent to the server in a
+	* single batch, rather than one round trip per setting.  PDO hands the
+	* same options to setAttribute() afterwards, which finds them in place.
+	*/
+	{
+		static const long session_attrs[] = {
+			PDO_INFORMIX_ATTR_ISOLATION, PDO_INFORMIX_ATTR_LOCK_WAIT,
+			PDO_INFORMIX_ATTR_PDQPRIORITY, PDO_INFORMIX_ATTR_OPTCOMPIND
+		};
+		for (i = 0; i < INFORMIX_SETTING_COUNT; i++) {
+			long value = pdo_attr_lval(driver_options, session_attrs[i],
+					INFORMIX_SETTING_UNSET TSRMLS_CC);
+			if (value != INFORMIX_SETTING_UNSET) {
+				int setting = session_setting_for_attr(session_attrs[i]);
+				conn_res->setting_initial[setting] = value;
+				if (session_want_setting(dbh, setting, value TSRMLS_CC) == FALSE) {
+					return FALSE;
+				}
+			}
+		}
+		if (conn_res->setting_pending && session_apply_settings(dbh TSRMLS_CC) == FALSE) {
+			return FALSE;
+		}
 	}
 
 	/* set the desired case to be upper */
@@ -703,6 +2013,7 @@ static int dbh_connect(pdo_dbh_t *dbh, zval *driver_options TSRMLS_DC)
 	/* this is now live!  all error handling goes through normal mechanisms. */
 	dbh->methods = &informix_dbh_methods;
 	dbh->alloc_own_columns = 1;
+	PDO_INFORMIX_G(connections_opened)++;
 	return TRUE;
 }
 
@@ -717,8 +2028,13 @@ static int informix_handle_factory(
 	zval *driver_options
 	TSRMLS_DC)
 {
+	int rc;
+
 	/* go do the connection */
-	return dbh_connect(dbh, driver_options TSRMLS_CC);
+	PDO_INFORMIX_CONNECT_ENTRY(dbh, dbh->data_source);
+	rc = dbh_connect(dbh, driver_options TSRMLS_CC);
+	PDO_INFORMIX_CONNECT_RETURN(dbh, rc);
+	return rc;
 }
 
 pdo_driver_t pdo_informix_driver =
@@ -769,6 +2085,7 @@ void raise_sql_error(pdo_dbh_t *dbh, pdo_stmt_t *stmt, SQLHANDLE handle,
 	SQLSMALLINT length;
 	conn_handle *conn_res = (conn_handle *) dbh->driver_data;
 
+	PDO_INFORMIX_G(errors)++;
 	conn_res->error_data.failure_name = tag;
 	conn_res->error_data.filename = file;
 	conn_res->error_data.lineno = line;
@@ -793,6 +2110,7 @@ void raise_informix_error(pdo_dbh_t *dbh, pdo_stmt_t *stmt, char *state, char *t
 {
 	conn_handle *conn_res = (conn_handle *) dbh->driver_data;
 
+	PDO_INFORMIX_G(errors)++;
 	conn_res->error_data.failure_name = tag;
 	conn_res->error_data.filename = file;
 	conn_res->error_data.lineno = line;
@@ -30,6 +30,177 @@
 #include "pdo/php_pdo_driver.h"
 #include "php_pdo_informix.h"
 #include "php_pdo_informix_int.h"
+#include "int8.h"
+#ifdef PHP_WIN32
+#include "win32/time.h"
+#else
+#include <sys/time.h>
+#endif
+#include <time.h>
+#include <ctype.h>
+#include "ext/date/php_date.h"
+
+/* a monotonic clock where the platform has one, wall clock time otherwise */
+double informix_clock(void)
+{
+#ifdef CLOCK_MONOTONIC
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+		return (double) ts.tv_sec + (double) ts.tv_nsec / 1000000000.0;
+	}
+#endif
+	{
+		struct timeval tv;
+
+		gettimeofday(&tv, NULL);
+		return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+	}
+}
+
+/* longest SQL text and parameter value written to the slow query log */
+#define SLOW_QUERY_MAX_SQL 4096
+#define SLOW_QUERY_MAX_VALUE 256
+
+/* append one bound parameter value to a slow query log entry */
+static void slow_query_append_value(smart_str *entry, zval *value TSRMLS_DC)
+{
+	zval tmp;
+
+	switch (Z_TYPE_P(value)) {
+		case IS_NULL:
+			smart_str_appends(entry, "NULL");
+			return;
+		case IS_RESOURCE:
+			smart_str_appends(entry, "<stream>");
+			return;
+		case IS_ARRAY:
+		case IS_OBJECT:
+			smart_str_appends(entry, "<complex>");
+			return;
+	}
+	tmp = *value;
+	zval_copy_ctor(&tmp);
+	convert_to_string(&tmp);
+	smart_str_appendc(entry, '\'');
+	if (Z_STRLEN(tmp) > SLOW_QUERY_MAX_VALUE) {
+		smart_str_appendl(entry, Z_STRVAL(tmp), SLOW_QUERY_MAX_VALUE);
+		smart_str_appends(entry, "...");
+	} else {
+		smart_str_appendl(entry, Z_STRVAL(tmp), Z_STRLEN(tmp));
+	}
+	smart_str_appendc(entry, '\'');
+	zval_dtor(&tmp);
+}
+
+/* append the bound parameters of an execution to a slow query log entry */
+static void slow_query_append_params(smart_str *entry, HashTable *params TSRMLS_DC)
+{
+	struct pdo_bound_param_data *param;
+	HashPosition pos;
+	int first = 1;
+
+	if (params == NULL || zend_hash_num_elements(params) == 0) {
+		return;
+	}
+	smart_str_appends(entry, " [");
+	zend_hash_internal_pointer_reset_ex(params, &pos);
+	while (zend_hash_get_current_data_ex(params, (void **) &param, &pos) == SUCCESS) {
+		if (!first) {
+			smart_str_appends(entry, ", ");
+		}
+		first = 0;
+		if (param->name != NULL) {
+			smart_str_appendl(entry, param->name, param->namelen);
+		} else {
+			smart_str_append_long(entry, param->paramno + 1);
+		}
+		smart_str_appends(entry, " => ");
+		if (PDO_INFORMIX_G(slow_query_redact)) {
+			smart_str_appendc(entry, '?');
+		} else {
+			slow_query_append_value(entry, param->parameter TSRMLS_CC);
+		}
+		zend_hash_move_forward_ex(params, &pos);
+	}
+	smart_str_appendc(entry, ']');
+}
+
+/*
+* Write a statement that ran for at least pdo_informix.slow_query_threshold_ms
+* to the slow query log, with its parameters as formatted by
+* slow_query_append_params(), its row count (negative when it failed) and
+* the time spent in each phase.
+*/
+void informix_slow_query_log(const char *sql, int sql_len, const char *params, long rows,
+	double execute_time, double fetch_time TSRMLS_DC)
+{
+	smart_str entry = {0};
+	char *line;
+
+	spprintf(&line, 0, "pdo_informix slow query: %.3f ms (execute %.3f ms, fetch %.3f ms), ",
+			(execute_time + fetch_time) * 1000.0, execute_time * 1000.0,
+			fetch_time * 1000.0);
+	smart_str_appends(&entry, line);
+	efree(line);
+	if (rows < 0) {
+		smart_str_appends(&entry, "failed: ");
+	} else {
+		smart_str_append_long(&entry, rows);
+		smart_str_appends(&entry, " rows: ");
+	}
+
+	if (sql_len > SLOW_QUERY_MAX_SQL) {
+		smart_str_appendl(&entry, sql, SLOW_QUERY_MAX_SQL);
+		smart_str_appends(&entry, "...");
+	} else {
+		smart_str_appendl(&entry, sql, sql_len);
+	}
+	if (params != NULL) {
+		smart_str_appends(&entry, params);
+	}
+	smart_str_0(&entry);
+
+	if (PDO_INFORMIX_G(slow_query_log) != NULL && *PDO_INFORMIX_G(slow_query_log) != '\0') {
+		FILE *log = VCWD_FOPEN(PDO_INFORMIX_G(slow_query_log), "a");
+		if (log != NULL) {
+			char *stamp = php_format_date("d-M-Y H:i:s e", 13, time(NULL), 1 TSRMLS_CC);
+			fprintf(log, "[%s] %s\n", stamp, entry.c);
+			efree(stamp);
+			fclose(log);
+		}
+	} else {
+		php_log_err(entry.c TSRMLS_CC);
+	}
+	smart_str_free(&entry);
+}
+
+/*
+* Log the last execution of a statement if it was slow.  A query's time
+* includes fetching its rows, so this happens once the result has been
+* read to the end, the statement is executed again or it is destroyed.
+* PDO has released or replaced the bound parameters by the last two, so
+* the parameters logged are the ones captured when the statement ran.
+*/
+void informix_slow_query_check(pdo_stmt_t *stmt TSRMLS_DC)
+{
+	stmt_handle *stmt_res = (stmt_handle *) stmt->driver_data;
+	double elapsed;
+
+	if (stmt_res == NULL || !stmt_res->slow_pending) {
+		return;
+	}
+	stmt_res->slow_pending = 0;
+
+	elapsed = (stmt_res->slow_execute_time + stmt_res->slow_fetch_time) * 1000.0;
+	if (INFORMIX_SLOW_QUERY_ENABLED() && elapsed >= PDO_INFORMIX_G(slow_query_threshold)) {
+		informix_slow_query_log(stmt->query_string, stmt->query_stringlen,
+				stmt_res->slow_params.c,
+				stmt->column_count > 0 ? stmt_res->exec_rows :
+					(stmt->row_count > 0 ? (long) stmt->row_count : 0),
+				stmt_res->slow_execute_time, stmt_res->slow_fetch_time TSRMLS_CC);
+	}
+}
 
 struct lob_stream_data
 {
@@ -48,6 +219,7 @@ size_t lob_stream_read(php_stream *stream, char *buf, size_t count TSRMLS_DC)
 	pdo_stmt_t *stmt = data->stmt;
 	int ctype = 0;
 	SQLRETURN rc = 0;
+	double start;
 
 	if (stream->eof == 1) {
 		return (size_t)-1;
@@ -67,7 +239,11 @@ size_t lob_stream_read(php_stream *stream, char *buf, size_t count TSRMLS_DC)
 			break;
 	}
 
+	INFORMIX_STATS_START(stmt_res, start);
+	PDO_INFORMIX_GETDATA_ENTRY(stmt, data->colno);
 	rc = SQLGetData(stmt_res->hstmt, data->colno + 1, ctype, buf, count, &readBytes);
+	PDO_INFORMIX_GETDATA_RETURN(stmt, data->colno, (long) readBytes);
+	INFORMIX_STATS_STOP(stmt_res, data_time, start, 1);
 	check_stmt_error(rc, "SQLGetData");
 
 	if (rc == SQL_NO_DATA) {	/*Already returned all of the data for the column*/
@@ -86,11 +262,26 @@ size_t lob_stream_read(php_stream *stream, char *buf, size_t count TSRMLS_DC)
 	} else if (count > readBytes) {
 		stream->eof = 1;
 	}
+	INFORMIX_STATS_ADD(stmt_res, lob_bytes, readBytes);
+	PDO_INFORMIX_G(lob_bytes) += readBytes;
 	return (size_t) readBytes;
 }
 
+/*
+* TEXT and BYTE values, and BLOB/CLOB values outside smart LOB mode, come
+* through SQLGetData and can only be replaced whole, by binding a stream to
+* an UPDATE.  Say so rather than dropping the data silently.
+*/
 size_t lob_stream_write(php_stream *stream, const char *buf, size_t count TSRMLS_DC)
 {
+	struct lob_stream_data *data = stream->abstract;
+	pdo_stmt_t *stmt = data->stmt;
+
+	RAISE_INFORMIX_STMT_ERROR("HY000", "lob_stream_write",
+		"LOB streams are only writable in smart LOB mode");
+	php_error_docref(NULL TSRMLS_CC, E_WARNING,
+		"This LOB stream cannot be written; use PDO::INFORMIX_ATTR_SMART_LOB on the connection "
+		"and select the column FOR UPDATE, or bind a stream to an UPDATE to replace the value");
 	return 0;
 }
 
@@ -131,6 +322,8 @@ php_stream* create_lob_stream( pdo_stmt_t *stmt , stmt_handle *stmt_res , int co
 	data->colno = colno;
 	col_res = &data->stmt_res->columns[data->colno];
 	retval = (php_stream *) php_stream_alloc(&lob_stream_ops, data, NULL, "r");
+	/* buffered reads go to SQLGetData a chunk at a time */
+	php_stream_set_chunk_size(retval, stmt_res->lob_chunk_size);
 	/* Find out if the column contains NULL data */
 	if (lob_stream_read(retval, buf, 0 TSRMLS_CC) == SQL_NULL_DATA) {
 		php_stream_close(retval);
@@ -139,6 +332,301 @@ php_stream* create_lob_stream( pdo_stmt_t *stmt , stmt_handle *stmt_res , int co
 		return retval;
 }
 
+/*
+* Smart large objects in smart LOB mode.  The column is fetched as an LO
+* pointer, and the stream opens the object through the ifx_lo_* functions
+* on a statement handle of its own, so that a script can seek to any offset
+* and read just the range it wants, or overwrite the object in place,
+* without the data in front of it crossing the network.  The object is only
+* opened on the first read, seek or write, so fetching rows whose LOBs are
+* never touched costs nothing beyond the LO pointer.  The stream keeps the
+* connection alive rather than the statement, so it stays usable after the
+* statement has gone; its errors are reported on the connection.
+*/
+struct smart_lob_stream_data
+{
+	pdo_dbh_t *dbh;
+	char *lo_ptr;		/* copy of the LO pointer the object is opened from */
+	int open;			/* the object is open and the handles below allocated */
+	SQLHANDLE hstmt;	/* open, seek, write and close */
+	SQLHANDLE hread;	/* ifx_lo_read, prepared once as reads dominate */
+	SQLINTEGER lofd;	/* the descriptor of the open object */
+	int writable;		/* opened with PDO::INFORMIX_ATTR_LOB_WRITABLE */
+};
+
+/*
+* Stream operations have no way to hand an error back to the script, so
+* besides recording it on the connection, say it in a warning.
+*/
+static void smart_lob_error(struct smart_lob_stream_data *data, SQLHANDLE handle,
+	SQLSMALLINT handle_type, char *tag, char *file, int line TSRMLS_DC)
+{
+	conn_handle *conn_res = (conn_handle *) data->dbh->driver_data;
+
+	raise_sql_error(data->dbh, NULL, handle, handle_type, tag, file, line TSRMLS_CC);
+	php_error_docref(NULL TSRMLS_CC, E_WARNING, "%s: SQLSTATE[%s] %d %s", tag,
+		conn_res->error_data.sql_state, (int) conn_res->error_data.sqlcode,
+		conn_res->error_data.err_msg);
+}
+
+#define RAISE_SMART_LOB_ERROR(data, handle, tag) \
+	smart_lob_error((data), (handle), SQL_HANDLE_STMT, (tag), __FILE__, __LINE__ TSRMLS_CC)
+
+/* open the object on first use; FALSE (with the error raised) if it cannot be */
+static int smart_lob_open(struct smart_lob_stream_data *data TSRMLS_DC)
+{
+	conn_handle *conn_res = (conn_handle *) data->dbh->driver_data;
+	SQLINTEGER mode = data->writable ? LO_RDWR : LO_RDONLY;
+	SQLLEN lofd_ind = 0, loptr_ind = conn_res->lo_ptr_length;
+	SQLRETURN rc;
+
+	if (data->open) {
+		return TRUE;
+	}
+
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn_res->hdbc, &data->hstmt);
+	if (rc == SQL_ERROR) {
+		smart_lob_error(data, conn_res->hdbc, SQL_HANDLE_DBC, "SQLAllocHandle",
+			__FILE__, __LINE__ TSRMLS_CC);
+		return FALSE;
+	}
+	rc = SQLAllocHandle(SQL_HANDLE_STMT, conn_res->hdbc, &data->hread);
+	if (rc == SQL_ERROR) {
+		smart_lob_error(data, conn_res->hdbc, SQL_HANDLE_DBC, "SQLAllocHandle",
+			__FILE__, __LINE__ TSRMLS_CC);
+		SQLFreeHandle(SQL_HANDLE_STMT, data->hstmt);
+		return FALSE;
+	}
+
+	rc = SQLBindParameter(data->hstmt, 1, SQL_PARAM_OUTPUT, SQL_C_LONG, SQL_INTEGER,
+			0, 0, &data->lofd, sizeof(data->lofd), &lofd_ind);
+	if (rc != SQL_ERROR) {
+		rc = SQLBindParameter(data->hstmt, 2, SQL_PARAM_INPUT, SQL_C_BINARY,
+				SQL_INFX_UDT_FIXED, conn_res->lo_ptr_length, 0, data->lo_ptr,
+				conn_res->lo_ptr_length, &loptr_ind);
+	}
+	if (rc != SQL_ERROR) {
+		rc = SQLBindParameter(data->hstmt, 3, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER,
+				0, 0, &mode, 0, NULL);
+	}
+	if (rc != SQL_ERROR) {
+		rc = SQLExecDirect(data->hstmt, (SQLCHAR *) "{? = call ifx_lo_open(?, ?)}", SQL_NTS);
+	}
+	SQLFreeStmt(data->hstmt, SQL_RESET_PARAMS);
+	if (rc == SQL_ERROR) {
+		RAISE_SMART_LOB_ERROR(data, data->hstmt, "ifx_lo_open");
+		SQLFreeHandle(SQL_HANDLE_STMT, data->hread);
+		SQLFreeHandle(SQL_HANDLE_STMT, data->hstmt);
+		return FALSE;
+	}
+	data->open = 1;
+
+	/* the descriptor stays bound; the buffer and count change with each read */
+	rc = SQLPrepare(data->hread, (SQLCHAR *) "{call ifx_lo_read(?, ?)}", SQL_NTS);
+	if (rc != SQL_ERROR) {
+		rc = SQLBindParameter(data->hread, 1, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER,
+				0, 0, &data->lofd, 0, NULL);
+	}
+	if (rc == SQL_ERROR) {
+		RAISE_SMART_LOB_ERROR(data, data->hread, "SQLPrepare");
+		return FALSE;
+	}
+	return TRUE;
+}
+
+static size_t smart_lob_stream_read(php_stream *stream, char *buf, size_t count TSRMLS_DC)
+{
+	struct smart_lob_stream_data *data = stream->abstract;
+	SQLLEN buf_ind = 0;
+	SQLRETURN rc;
+
+	if (!smart_lob_open(data TSRMLS_CC)) {
+		stream->eof = 1;
+		return 0;
+	}
+
+	/* the length indicator of the buffer says how many bytes were read */
+	rc = SQLBindParameter(data->hread, 2, SQL_PARAM_OUTPUT, SQL_C_BINARY,
+			SQL_LONGVARBINARY, count, 0, buf, count, &buf_ind);
+	if (rc != SQL_ERROR) {
+		rc = SQLExecute(data->hread);
+	}
+	if (rc == SQL_ERROR) {
+		RAISE_SMART_LOB_ERROR(data, data->hread, "ifx_lo_read");
+		stream->eof = 1;
+		return 0;
+	}
+
+	if (buf_ind <= 0) {
+		stream->eof = 1;
+		return 0;
+	}
+	if ((size_t) buf_ind > count) {
+		buf_ind = count;
+	}
+	PDO_INFORMIX_G(lob_bytes) += buf_ind;
+	return (size_t) buf_ind;
+}
+
+static size_t smart_lob_stream_write(php_stream *stream, const char *buf, size_t count TSRMLS_DC)
+{
+	struct smart_lob_stream_data *data = stream->abstract;
+	SQLLEN buf_ind = count;
+	SQLRETURN rc;
+
+	if (!data->writable) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING,
+			"The LOB stream is read-only; select the column FOR UPDATE or set "
+			"PDO::INFORMIX_ATTR_LOB_WRITABLE on the statement to write");
+		return 0;
+	}
+	if (!smart_lob_open(data TSRMLS_CC)) {
+		return 0;
+	}
+
+	rc = SQLBindParameter(data->hstmt, 1, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER,
+			0, 0, &data->lofd, 0, NULL);
+	if (rc != SQL_ERROR) {
+		rc = SQLBindParameter(data->hstmt, 2, SQL_PARAM_INPUT, SQL_C_BINARY,
+				SQL_LONGVARBINARY, count, 0, (SQLPOINTER) buf, count, &buf_ind);
+	}
+	if (rc != SQL_ERROR) {
+		rc = SQLExecDirect(data->hstmt, (SQLCHAR *) "{call ifx_lo_write(?, ?)}", SQL_NTS);
+	}
+	SQLFreeStmt(data->hstmt, SQL_RESET_PARAMS);
+	if (rc == SQL_ERROR) {
+		RAISE_SMART_LOB_ERROR(data, data->hstmt, "ifx_lo_write");
+		return 0;
+	}
+
+	/* a write either stores the whole buffer or fails */
+	PDO_INFORMIX_G(lob_bytes) += count;
+	return count;
+}
+
+static int smart_lob_stream_flush(php_stream *stream TSRMLS_DC)
+{
+	/* every write goes straight to the server */
+	return 0;
+}
+
+/*
+* Offsets in a smart large object are INT8s, which the CLI exchanges in the
+* ESQL/C ifx_int8_t form; doubles hold any offset exactly up to 2^53.
+*/
+static int smart_lob_stream_seek(php_stream *stream, off_t offset, int whence,
+	off_t *newoffset TSRMLS_DC)
+{
+	struct smart_lob_stream_data *data = stream->abstract;
+	ifx_int8_t off8, pos8;
+	SQLINTEGER lo_whence;
+	SQLLEN off8_ind = sizeof(ifx_int8_t), pos8_ind = sizeof(ifx_int8_t);
+	double pos = 0;
+	SQLRETURN rc;
+
+	switch (whence) {
+		case SEEK_CUR:
+			lo_whence = LO_SEEK_CUR;
+			break;
+		case SEEK_END:
+			lo_whence = LO_SEEK_END;
+			break;
+		default:
+			lo_whence = LO_SEEK_SET;
+			break;
+	}
+	if (!smart_lob_open(data TSRMLS_CC)) {
+		return -1;
+	}
+	ifx_int8cvdbl((double) offset, &off8);
+	ifx_int8cvdbl(0.0, &pos8);
+
+	rc = SQLBindParameter(data->hstmt, 1, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER,
+			0, 0, &data->lofd, 0, NULL);
+	if (rc != SQL_ERROR) {
+		rc = SQLBindParameter(data->hstmt, 2, SQL_PARAM_INPUT, SQL_C_BINARY,
+				SQL_INFX_UDT_FIXED, sizeof(ifx_int8_t), 0, &off8, sizeof(ifx_int8_t), &off8_ind);
+	}
+	if (rc != SQL_ERROR) {
+		rc = SQLBindParameter(data->hstmt, 3, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER,
+				0, 0, &lo_whence, 0, NULL);
+	}
+	if (rc != SQL_ERROR) {
+		rc = SQLBindParameter(data->hstmt, 4, SQL_PARAM_INPUT_OUTPUT, SQL_C_BINARY,
+				SQL_INFX_UDT_FIXED, sizeof(ifx_int8_t), 0, &pos8, sizeof(ifx_int8_t), &pos8_ind);
+	}
+	if (rc != SQL_ERROR) {
+		rc = SQLExecDirect(data->hstmt, (SQLCHAR *) "{call ifx_lo_seek(?, ?, ?, ?)}", SQL_NTS);
+	}
+	SQLFreeStmt(data->hstmt, SQL_RESET_PARAMS);
+	if (rc == SQL_ERROR) {
+		RAISE_SMART_LOB_ERROR(data, data->hstmt, "ifx_lo_seek");
+		return -1;
+	}
+
+	ifx_int8todbl(&pos8, &pos);
+	*newoffset = (off_t) pos;
+	return 0;
+}
+
+static int smart_lob_stream_close(php_stream *stream, int close_handle TSRMLS_DC)
+{
+	struct smart_lob_stream_data *data = stream->abstract;
+	SQLRETURN rc;
+
+	/* a failed close is reported but still releases everything */
+	if (data->open) {
+		rc = SQLBindParameter(data->hstmt, 1, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER,
+				0, 0, &data->lofd, 0, NULL);
+		if (rc != SQL_ERROR) {
+			rc = SQLExecDirect(data->hstmt, (SQLCHAR *) "{call ifx_lo_close(?)}", SQL_NTS);
+		}
+		if (rc == SQL_ERROR) {
+			RAISE_SMART_LOB_ERROR(data, data->hstmt, "ifx_lo_close");
+		}
+		SQLFreeHandle(SQL_HANDLE_STMT, data->hread);
+		SQLFreeHandle(SQL_HANDLE_STMT, data->hstmt);
+	}
+	php_pdo_dbh_delref(data->dbh TSRMLS_CC);
+	efree(data->lo_ptr);
+	efree(data);
+	return 0;
+}
+
+php_stream_ops smart_lob_stream_ops = {
+	smart_lob_stream_write,	/* Write */
+	smart_lob_stream_read,	/* Read */
+	smart_lob_stream_close,	/* Close */
+	smart_lob_stream_flush,	/* Flush */
+	"informix PDO smart LOB stream",
+	smart_lob_stream_seek,	/* Seek */
+	NULL,			/* GetS */
+	NULL,			/* Cast */
+	NULL			/* Stat */
+};
+
+/* a stream over the smart large object whose LO pointer was fetched into column colno */
+static php_stream *create_smart_lob_stream(pdo_stmt_t *stmt, stmt_handle *stmt_res, int colno TSRMLS_DC)
+{
+	conn_handle *conn_res = (conn_handle *) stmt->dbh->driver_data;
+	struct smart_lob_stream_data *data;
+	php_stream *retval;
+
+	data = ecalloc(1, sizeof(struct smart_lob_stream_data));
+	data->dbh = stmt->dbh;
+	data->writable = stmt_res->lob_writable;
+	/* the pointer is copied, as the next fetch overwrites the column buffer */
+	data->lo_ptr = emalloc(conn_res->lo_ptr_length);
+	memcpy(data->lo_ptr, stmt_res->columns[colno].data.str_val, conn_res->lo_ptr_length);
+
+	php_pdo_dbh_addref(stmt->dbh TSRMLS_CC);
+	retval = (php_stream *) php_stream_alloc(&smart_lob_stream_ops, data, NULL,
+			stmt_res->lob_writable ? "r+b" : "rb");
+	/* each buffered read is one ifx_lo_read call */
+	php_stream_set_chunk_size(retval, stmt_res->lob_chunk_size);
+	return retval;
+}
+
 /*
 * Clear up our column descriptors.  This is done either from
 * the statement constructors or whenever we traverse from one
@@ -152,18 +640,22 @@ static void stmt_free_column_descriptors(pdo_stmt_t *stmt TSRMLS_DC)
 		/* see if any of the columns have attached storage too. */
 		for (i = 0; i < stmt->column_count; i++) {
 			/*
-			 * Was this a string form?  We have an allocated string
-			 * buffer that also needs releasing.
+			 * Was the column given a buffer?  The returned type does not
+			 * say, as a bound LOB column changes it.
 			 */
-			if (stmt_res->columns[i].returned_type == PDO_PARAM_STR) {
+			if (stmt_res->columns[i].owns_str_val) {
 				efree(stmt_res->columns[i].data.str_val);
 			}
+			if (stmt_res->columns[i].complex_type != NULL) {
+				efree(stmt_res->columns[i].complex_type);
+			}
 		}
 
 		/* free the entire column list. */
 		efree(stmt_res->columns);
 		stmt_res->columns = NULL;
 	}
+	stmt_res->columns_described = 0;
 }
 
 /*
@@ -183,6 +675,7 @@ void stmt_cleanup(pdo_stmt_t *stmt TSRMLS_DC)
 		}
 		/* free any descriptors we're keeping active */
 		stmt_free_column_descriptors(stmt TSRMLS_CC);
+		smart_str_free(&stmt_res->slow_params);
 		efree(stmt_res);
 	}
 	stmt->driver_data = NULL;
@@ -255,6 +748,11 @@ static int stmt_get_parameter_info(pdo_stmt_t * stmt, struct pdo_bound_param_dat
 				param_res->ctype = SQL_C_LONG;
 				break;
 
+			/* BOOLEAN takes a single byte */
+			case SQL_BIT:
+				param_res->ctype = SQL_C_BIT;
+				break;
+
 			/* everything else will transfer as binary */
 			default:
 				/* by default, we transfer as character data */
@@ -265,6 +763,45 @@ static int stmt_get_parameter_info(pdo_stmt_t * stmt, struct pdo_bound_param_dat
 	return TRUE;
 }
 
+/*
+* The truth value of a PHP value bound to a BOOLEAN parameter.  Besides the
+* usual PHP rules, the "t" and "f" strings Informix itself uses are honoured.
+*/
+static unsigned char informix_bit_value(zval *value)
+{
+	if (Z_TYPE_P(value) == IS_STRING && Z_STRLEN_P(value) == 1) {
+		switch (Z_STRVAL_P(value)[0]) {
+			case 't':
+			case 'T':
+				return 1;
+			case 'f':
+			case 'F':
+				return 0;
+		}
+	}
+	return zend_is_true(value) ? 1 : 0;
+}
+
+/*
+* Bind a BOOLEAN parameter to its one byte buffer.  The value itself is
+* picked up from the PHP variable just before each execute.
+*/
+static int stmt_bind_bit_parameter(pdo_stmt_t *stmt, struct pdo_bound_param_data *curr,
+	param_node *param_res, SQLSMALLINT inputOutputType TSRMLS_DC)
+{
+	stmt_handle *stmt_res = (stmt_handle *) stmt->driver_data;
+	int rc;
+
+	param_res->transfer_length = Z_TYPE_P(curr->parameter) == IS_NULL ? SQL_NULL_DATA : 1;
+	rc = SQLBindParameter(stmt_res->hstmt, curr->paramno + 1,
+			inputOutputType, SQL_C_BIT,
+			param_res->data_type, 1, 0,
+			&param_res->bit_val, 1,
+			&param_res->transfer_length);
+	check_stmt_error(rc, "SQLBindParameter");
+	return TRUE;
+}
+
 /*
 * Bind a statement parameter to the PHP value supplying or receiving the
 * parameter data.
@@ -377,6 +914,10 @@ int stmt_bind_parameter(pdo_stmt_t *stmt, struct pdo_bound_param_data *curr TSRM
 		/* a string value (very common) */
 		case PDO_PARAM_BOOL:
 		case PDO_PARAM_STR:
+			/* a BOOLEAN parameter takes a byte, whatever PHP type supplies it */
+			if (param_res->ctype == SQL_C_BIT) {
+				return stmt_bind_bit_parameter(stmt, curr, param_res, inputOutputType TSRMLS_CC);
+			}
 			/*
 			* If we're capable of handling an integer value, but
 			* PDO  is telling us string, then change this now.
@@ -555,81 +1096,613 @@ static int stmt_parameter_pre_execute(pdo_stmt_t *stmt, struct pdo_bound_param_d
 			param_res->transfer_length = SQL_LEN_DATA_AT_EXEC(Z_STRLEN_P(curr->parameter));
 		}
 
-	} else {
-		if (Z_TYPE_P(curr->parameter) != IS_NULL && param_res != NULL) {
-			/*
-			* if we're processing this as string or binary data,
-			* then directly update the length to the real value.
-			*/
-			if (param_res->ctype == SQL_C_LONG) {
-				/* make sure this is a long value */
-				convert_to_long(curr->parameter);
-			} else {
-				/*
-				* Make sure this is a string value...it might
-				* have been changed between the bind and the
-				* execute
-				*/
-				convert_to_string(curr->parameter);
-				param_res->transfer_length = Z_STRLEN_P(curr->parameter);
-			}
-		}
+	} else if (param_res != NULL && param_res->ctype == SQL_C_BIT) {
+		/* BOOLEAN values go as a single byte */
+		if (Z_TYPE_P(curr->parameter) == IS_NULL) {
+			param_res->transfer_length = SQL_NULL_DATA;
+		} else {
+			param_res->bit_val = informix_bit_value(curr->parameter);
+			param_res->transfer_length = 1;
+		}
+	} else {
+		if (Z_TYPE_P(curr->parameter) != IS_NULL && param_res != NULL) {
+			/*
+			* if we're processing this as string or binary data,
+			* then directly update the length to the real value.
+			*/
+			if (param_res->ctype == SQL_C_LONG) {
+				/* make sure this is a long value */
+				convert_to_long(curr->parameter);
+			} else {
+				/*
+				* Make sure this is a string value...it might
+				* have been changed between the bind and the
+				* execute
+				*/
+				convert_to_string(curr->parameter);
+				param_res->transfer_length = Z_STRLEN_P(curr->parameter);
+			}
+		}
+	}
+	return TRUE;
+}
+
+/* post-execution bound parameter handling. */
+static int stmt_parameter_post_execute(pdo_stmt_t *stmt, struct pdo_bound_param_data *curr TSRMLS_DC)
+{
+	param_node *param_res = (param_node *) curr->driver_data;
+
+	/*
+	* If the type of the parameter is a string, we need to update the
+	* string length and make sure that these are null terminated.
+	* Values returned from the DB are just copied directly into the bound
+	* locations, so we need to update the PHP control blocks so that the
+	* data is processed correctly.
+	*/
+	if (param_res != NULL && param_res->ctype == SQL_C_BIT) {
+		/* an output BOOLEAN comes back as a PHP boolean */
+		if ((curr->param_type & PDO_PARAM_INPUT_OUTPUT) || curr->max_value_len > 0) {
+			zval_dtor(curr->parameter);
+			if (param_res->transfer_length == SQL_NULL_DATA) {
+				ZVAL_NULL(curr->parameter);
+			} else {
+				ZVAL_BOOL(curr->parameter, param_res->bit_val);
+			}
+		}
+	} else if ((param_res != NULL) && (Z_TYPE_P(curr->parameter) == IS_STRING)) {
+		if (param_res->transfer_length < 0 || param_res->transfer_length == SQL_NULL_DATA) {
+			Z_STRLEN_P(curr->parameter) = 0;
+			Z_STRVAL_P(curr->parameter)[0] = '\0';
+		} else if (param_res->transfer_length == 0) {
+			ZVAL_EMPTY_STRING(curr->parameter);
+		} else {
+			Z_STRLEN_P(curr->parameter) = param_res->transfer_length;
+			Z_STRVAL_P(curr->parameter)[param_res->transfer_length] = '\0';
+		}
+	}
+	return TRUE;
+}
+
+/* longest ISO-8601 text we produce, "YYYY-MM-DDTHH:MM:SS.fffffffff" */
+#define INFORMIX_ISO8601_LENGTH 29
+
+/* write a zero padded decimal number of the given width */
+static char *informix_put_digits(char *p, unsigned long n, int width)
+{
+	char *end = p + width;
+
+	while (width-- > 0) {
+		p[width] = (char) ('0' + n % 10);
+		n /= 10;
+	}
+	return end;
+}
+
+/*
+* Format a DATE or DATETIME fetched in binary form as ISO-8601 text.
+* The fraction keeps as many digits as the column has.  Returns the length.
+*/
+static int informix_temporal_to_iso8601(const TIMESTAMP_STRUCT *ts, SQLSMALLINT data_type,
+	SQLSMALLINT scale, char *out)
+{
+	char *p = out;
+
+	p = informix_put_digits(p, ts->year < 0 ? 0 : ts->year, 4);
+	*p++ = '-';
+	p = informix_put_digits(p, ts->month, 2);
+	*p++ = '-';
+	p = informix_put_digits(p, ts->day, 2);
+	if (data_type == SQL_TYPE_TIMESTAMP) {
+		*p++ = 'T';
+		p = informix_put_digits(p, ts->hour, 2);
+		*p++ = ':';
+		p = informix_put_digits(p, ts->minute, 2);
+		*p++ = ':';
+		p = informix_put_digits(p, ts->second, 2);
+		if (scale > 0) {
+			/* the fraction is in nanoseconds */
+			unsigned long fraction = ts->fraction;
+			int digits = scale > 9 ? 9 : scale, i;
+
+			for (i = digits; i < 9; i++) {
+				fraction /= 10;
+			}
+			*p++ = '.';
+			p = informix_put_digits(p, fraction, digits);
+		}
+	}
+	*p = '\0';
+	return (int) (p - out);
+}
+
+/*
+* Convert a DATE or DATETIME fetched in binary form to a Unix timestamp,
+* reading it in the default time zone as strtotime() would.  Fractions of
+* a second are dropped.
+*/
+static long informix_temporal_to_unix(const TIMESTAMP_STRUCT *ts TSRMLS_DC)
+{
+	timelib_tzinfo *tzi = get_timezone_info(TSRMLS_C);
+	timelib_time *t = timelib_time_ctor();
+	long sse;
+
+	t->y = ts->year;
+	t->m = ts->month;
+	t->d = ts->day;
+	t->h = ts->hour;
+	t->i = ts->minute;
+	t->s = ts->second;
+	t->tz_info = tzi;
+	t->zone_type = TIMELIB_ZONETYPE_ID;
+	timelib_update_ts(t, tzi);
+	sse = (long) t->sse;
+	timelib_time_dtor(t);
+	return sse;
+}
+
+/*
+* Bind a fixed size column buffer.  In lazy fetch mode nothing is bound:
+* the buffer is only noted, and get_col fills it with SQLGetData if and
+* when PDO asks for the column, so that SQLFetchScroll converts none of
+* the columns a script never looks at.
+*/
+static int stmt_bind_column_buffer(pdo_stmt_t *stmt, int colno, SQLSMALLINT ctype,
+	SQLPOINTER target, SQLLEN length TSRMLS_DC)
+{
+	stmt_handle *stmt_res = (stmt_handle *) stmt->driver_data;
+	column_data *col_res = &stmt_res->columns[colno];
+	int rc;
+
+	if (stmt_res->lazy_fetch) {
+		col_res->unbound = 1;
+		col_res->unbound_ctype = ctype;
+		col_res->unbound_target = target;
+		col_res->unbound_length = length;
+		return TRUE;
+	}
+	rc = SQLBindCol((SQLHSTMT) stmt_res->hstmt, (SQLUSMALLINT) (colno + 1),
+			ctype, target, length, (SQLLEN *) (&col_res->out_length));
+	check_stmt_error(rc, "SQLBindCol");
+	return TRUE;
+}
+
+/*
+* Bind a DATE or DATETIME column to a TIMESTAMP_STRUCT, so that the client
+* library hands back the fields instead of formatting text we (or the
+* application) would only have to parse again.  DATE columns use the
+* DATE_STRUCT prefix of the same buffer.
+*/
+static int stmt_bind_temporal_column(pdo_stmt_t *stmt, int colno TSRMLS_DC)
+{
+	stmt_handle *stmt_res = (stmt_handle *) stmt->driver_data;
+	column_data *col_res = &stmt_res->columns[colno];
+	struct pdo_column_data *col = &stmt->columns[colno];
+
+	memset(&col_res->ts_val, 0, sizeof(col_res->ts_val));
+	if (!stmt_bind_column_buffer(stmt, colno,
+			col_res->data_type == SQL_TYPE_DATE ? SQL_C_TYPE_DATE : SQL_C_TYPE_TIMESTAMP,
+			&col_res->ts_val, sizeof(col_res->ts_val) TSRMLS_CC)) {
+		return FALSE;
+	}
+
+	col_res->temporal_mode = stmt_res->temporal_mode;
+	if (col_res->temporal_mode == PDO_INFORMIX_TEMPORAL_UNIX) {
+		col_res->returned_type = PDO_PARAM_INT;
+		col->param_type = PDO_PARAM_INT;
+		col_res->get_col = get_col_unix;
+	} else {
+		/* the text is built here at fetch time */
+		col_res->data.str_val = (char *) emalloc(INFORMIX_ISO8601_LENGTH + 1);
+		check_stmt_allocation(col_res->data.str_val,
+				"stmt_bind_temporal_column",
+				"Unable to allocate column buffer");
+		col_res->owns_str_val = 1;
+		col_res->returned_type = PDO_PARAM_STR;
+		col->param_type = PDO_PARAM_STR;
+		col_res->get_col = get_col_iso8601;
+	}
+	return TRUE;
+}
+
+/*
+* Walking a collection or ROW type name, such as
+*
+*   ROW(w INTEGER, h INTEGER)    LIST(ROW(id INTEGER, tags SET(CHAR(8) NOT NULL)) NOT NULL)
+*
+* alongside a value, to key the fields of its ROWs by name.  A named ROW
+* type only gives its name, so its fields stay numbered.
+*/
+static const char *complex_type_space(const char *t)
+{
+	while (isspace((unsigned char) *t)) {
+		t++;
+	}
+	return t;
+}
+
+/*
+* The first member of a ROW or collection type: the first field's name, or
+* the element type.  NULL when the type is neither.
+*/
+static const char *complex_type_members(const char *t, int *is_row)
+{
+	const char *word = complex_type_space(t), *p = word;
+	int len;
+
+	while (isalpha((unsigned char) *p)) {
+		p++;
+	}
+	len = p - word;
+	if (len == 0 || *(p = complex_type_space(p)) != '(') {
+		return NULL;
+	}
+	*is_row = len == 3 && strncasecmp(word, "ROW", 3) == 0;
+	return complex_type_space(p + 1);
+}
+
+/* the next ROW field after the one at t, or NULL after the last */
+static const char *complex_type_next_field(const char *t)
+{
+	int depth = 0;
+
+	for (; *t != '\0'; t++) {
+		if (*t == '(') {
+			depth++;
+		} else if (*t == ')') {
+			if (depth-- == 0) {
+				return NULL;
+			}
+		} else if (*t == ',' && depth == 0) {
+			return complex_type_space(t + 1);
+		}
+	}
+	return NULL;
+}
+
+/*
+* Decode the text form of a collection or ROW value, such as
+*
+*   MULTISET{'red','it''s'}    LIST{ROW(1,'a'),ROW(2,NULL)}
+*
+* into nested arrays.  Quoted elements are unescaped, NULL becomes null and
+* anything else (numbers, dates, ...) is kept as its text.  Given the type
+* name (or NULL), ROW fields are keyed by their names.  Text cut short by a
+* too small buffer decodes as far as it goes and sets *truncated.  Returns
+* the position after the value.
+*/
+static const char *informix_complex_decode(const char *p, const char *end, const char *type,
+	zval *value, int *truncated TSRMLS_DC)
+{
+	const char *start, *word_end;
+
+	while (p < end && isspace((unsigned char) *p)) {
+		p++;
+	}
+	start = p;
+
+	if (p < end && *p == '\'') {
+		smart_str buf = {0};
+		int closed = 0;
+
+		for (p++; p < end; p++) {
+			if (*p == '\'') {
+				if (p + 1 < end && p[1] == '\'') {
+					p++;
+				} else {
+					p++;
+					closed = 1;
+					break;
+				}
+			}
+			smart_str_appendc(&buf, *p);
+		}
+		if (!closed) {
+			*truncated = 1;
+		}
+		if (buf.c != NULL) {
+			smart_str_0(&buf);
+			ZVAL_STRINGL(value, buf.c, buf.len, 0);
+		} else {
+			ZVAL_EMPTY_STRING(value);
+		}
+		return p;
+	}
+
+	/* SET{...}, MULTISET{...}, LIST{...} and ROW(...) */
+	while (p < end && (isalpha((unsigned char) *p) || *p == '_')) {
+		p++;
+	}
+	word_end = p;
+	while (p < end && isspace((unsigned char) *p)) {
+		p++;
+	}
+	if (word_end > start && p < end && (*p == '{' || *p == '(')) {
+		char close = *p == '{' ? '}' : ')';
+		const char *member = NULL;
+		int is_row = 0;
+
+		if (type != NULL) {
+			member = complex_type_members(type, &is_row);
+		}
+		array_init(value);
+		for (p++; p < end; ) {
+			const char *name = NULL, *name_end = NULL, *member_type = member;
+			zval *element;
+
+			while (p < end && isspace((unsigned char) *p)) {
+				p++;
+			}
+			if (p >= end) {
+				break;
+			}
+			if (*p == close) {
+				return p + 1;
+			}
+			if (is_row && member != NULL) {
+				/* the field's name, then its type */
+				name = name_end = member;
+				while (*name_end != '\0' && !isspace((unsigned char) *name_end) &&
+						*name_end != ',' && *name_end != ')') {
+					name_end++;
+				}
+				member_type = complex_type_space(name_end);
+				member = complex_type_next_field(member);
+			}
+			MAKE_STD_ZVAL(element);
+			p = informix_complex_decode(p, end, member_type, element, truncated TSRMLS_CC);
+			if (name != NULL && name_end > name) {
+				char *key = estrndup(name, name_end - name);
+				add_assoc_zval_ex(value, key, name_end - name + 1, element);
+				efree(key);
+			} else {
+				add_next_index_zval(value, element);
+			}
+			while (p < end && isspace((unsigned char) *p)) {
+				p++;
+			}
+			if (p < end && *p == ',') {
+				p++;
+			}
+		}
+		*truncated = 1;
+		return p;
+	}
+
+	if (word_end - start == 4 && strncasecmp(start, "NULL", 4) == 0) {
+		ZVAL_NULL(value);
+		return word_end;
+	}
+
+	/* a literal, up to the next separator */
+	while (p < end && *p != ',' && *p != '}' && *p != ')') {
+		p++;
+	}
+	for (word_end = p; word_end > start && isspace((unsigned char) word_end[-1]); word_end--) {
+	}
+	ZVAL_STRINGL(value, start, word_end - start, 1);
+	return p;
+}
+
+/*
+* Column accessors.  stmt_bind_column() picks one per column, so that the
+* per-row work in get_col is a single call with no tests of the column's
+* type.  Each hands PDO the value of the current row.
+*/
+
+/* smart LOB: a stream opened from the LO pointer */
+static int get_col_smart_lob(pdo_stmt_t *stmt, int colno, column_data *col_res,
+	char **ptr, unsigned long *len TSRMLS_DC)
+{
+	if (col_res->out_length == SQL_NULL_DATA) {
+		*ptr = NULL;
+	} else {
+		*ptr = (char *) create_smart_lob_stream(stmt, (stmt_handle *) stmt->driver_data,
+				colno TSRMLS_CC);
+	}
+	*len = 0;
+	return TRUE;
+}
+
+/* TEXT, BYTE and the like: a stream reading the column with SQLGetData */
+static int get_col_lob(pdo_stmt_t *stmt, int colno, column_data *col_res,
+	char **ptr, unsigned long *len TSRMLS_DC)
+{
+	/* NULL when the value is */
+	*ptr = (char *) create_lob_stream(stmt, (stmt_handle *) stmt->driver_data, colno TSRMLS_CC);
+	*len = 0;
+	return TRUE;
+}
+
+/* collection or ROW literal; PDO takes the zval over and releases it */
+static int get_col_complex(pdo_stmt_t *stmt, int colno, column_data *col_res,
+	char **ptr, unsigned long *len TSRMLS_DC)
+{
+	int truncated = 0;
+
+	if (col_res->out_length == SQL_NULL_DATA) {
+		*ptr = NULL;
+		*len = 0;
+		return TRUE;
+	}
+	MAKE_STD_ZVAL(col_res->complex_val);
+	informix_complex_decode(col_res->data.str_val,
+			col_res->data.str_val + strlen(col_res->data.str_val),
+			col_res->complex_type, col_res->complex_val, &truncated TSRMLS_CC);
+	if (truncated) {
+		php_error_docref(NULL TSRMLS_CC, E_WARNING,
+			"Column %d: the collection or ROW value did not fit the column buffer and "
+			"is incomplete; a PDO::INFORMIX_ATTR_MAX_BIND_SIZE below the column's size "
+			"reads it whole", colno + 1);
+	}
+	*ptr = (char *) &col_res->complex_val;
+	*len = sizeof(zval);
+	return TRUE;
+}
+
+/* DATE/DATETIME fetched in binary form, as a Unix timestamp */
+static int get_col_unix(pdo_stmt_t *stmt, int colno, column_data *col_res,
+	char **ptr, unsigned long *len TSRMLS_DC)
+{
+	if (col_res->out_length == SQL_NULL_DATA) {
+		*ptr = NULL;
+		*len = 0;
+		return TRUE;
 	}
+	col_res->data.l_val = informix_temporal_to_unix(&col_res->ts_val TSRMLS_CC);
+	*ptr = (char *) &col_res->data.l_val;
+	*len = sizeof(long);
 	return TRUE;
 }
 
-/* post-execution bound parameter handling. */
-static int stmt_parameter_post_execute(pdo_stmt_t *stmt, struct pdo_bound_param_data *curr TSRMLS_DC)
+/* DATE/DATETIME fetched in binary form, as ISO 8601 text */
+static int get_col_iso8601(pdo_stmt_t *stmt, int colno, column_data *col_res,
+	char **ptr, unsigned long *len TSRMLS_DC)
 {
-	param_node *param_res = (param_node *) curr->driver_data;
+	if (col_res->out_length == SQL_NULL_DATA) {
+		*ptr = NULL;
+		*len = 0;
+		return TRUE;
+	}
+	*len = informix_temporal_to_iso8601(&col_res->ts_val, col_res->data_type,
+			col_res->scale, col_res->data.str_val);
+	*ptr = col_res->data.str_val;
+	return TRUE;
+}
 
-	/*
-	* If the type of the parameter is a string, we need to update the
-	* string length and make sure that these are null terminated.
-	* Values returned from the DB are just copied directly into the bound
-	* locations, so we need to update the PHP control blocks so that the
-	* data is processed correctly.
-	*/
-	if ((param_res != NULL) && (Z_TYPE_P(curr->parameter) == IS_STRING)) {
-		if (param_res->transfer_length < 0 || param_res->transfer_length == SQL_NULL_DATA) {
-			Z_STRLEN_P(curr->parameter) = 0;
-			Z_STRVAL_P(curr->parameter)[0] = '\0';
-		} else if (param_res->transfer_length == 0) {
-			ZVAL_EMPTY_STRING(curr->parameter);
-		} else {
-			Z_STRLEN_P(curr->parameter) = param_res->transfer_length;
-			Z_STRVAL_P(curr->parameter)[param_res->transfer_length] = '\0';
-		}
+/* BOOLEAN, bound as a single byte */
+static int get_col_bool(pdo_stmt_t *stmt, int colno, column_data *col_res,
+	char **ptr, unsigned long *len TSRMLS_DC)
+{
+	if (col_res->out_length == SQL_NULL_DATA) {
+		*ptr = NULL;
+		*len = 0;
+		return TRUE;
+	}
+	*ptr = (char *) &col_res->data.b_val;
+	*len = sizeof(zend_bool);
+	return TRUE;
+}
+
+/* string type...very common */
+static int get_col_str(pdo_stmt_t *stmt, int colno, column_data *col_res,
+	char **ptr, unsigned long *len TSRMLS_DC)
+{
+	if (col_res->out_length == SQL_NULL_DATA) {
+		*ptr = NULL;
+		*len = 0;
+	} else if (col_res->out_length == SQL_NTS) {
+		/* "count the length yourself" */
+		*ptr = col_res->data.str_val;
+		*len = col_res->data.str_val ? strlen(col_res->data.str_val) : 0;
+	} else {
+		*ptr = col_res->data.str_val;
+		*len = col_res->out_length;
 	}
 	return TRUE;
 }
 
+/* integers fetched as text; a length no integer can have is taken as NULL */
+static int get_col_integer_str(pdo_stmt_t *stmt, int colno, column_data *col_res,
+	char **ptr, unsigned long *len TSRMLS_DC)
+{
+	if (col_res->out_length != SQL_NULL_DATA && col_res->out_length != SQL_NTS &&
+			col_res->out_length > 20) {
+		*ptr = NULL;
+		*len = 0;
+		return TRUE;
+	}
+	return get_col_str(stmt, colno, col_res, ptr, len TSRMLS_CC);
+}
+
+/* the type name of a column, such as ROW(w INTEGER, h INTEGER); NULL if unavailable */
+static char *stmt_column_type_name(pdo_stmt_t *stmt, int colno TSRMLS_DC)
+{
+	stmt_handle *stmt_res = (stmt_handle *) stmt->driver_data;
+	char tmp_name[BUFSIZ];
+	char *name;
+	SQLSMALLINT length = 0;
+	SQLRETURN rc;
+
+	rc = SQLColAttribute(stmt_res->hstmt, colno + 1, SQL_DESC_TYPE_NAME,
+			tmp_name, sizeof(tmp_name), &length, NULL);
+	if (rc == SQL_ERROR || length <= 0) {
+		return NULL;
+	}
+	if (length < (SQLSMALLINT) sizeof(tmp_name)) {
+		return estrndup(tmp_name, length);
+	}
+	/* a deeply nested type can be longer than the buffer */
+	name = emalloc(length + 1);
+	rc = SQLColAttribute(stmt_res->hstmt, colno + 1, SQL_DESC_TYPE_NAME,
+			name, length + 1, &length, NULL);
+	if (rc == SQL_ERROR) {
+		efree(name);
+		return NULL;
+	}
+	return name;
+}
+
 /* bind a column to an internally allocated buffer location. */
 static int stmt_bind_column(pdo_stmt_t *stmt, int colno TSRMLS_DC)
 {
 	stmt_handle *stmt_res;
+	conn_handle *conn_res;
 	column_data *col_res;
 	struct pdo_column_data *col;
 	int rc;
 	SQLLEN in_length = 1;
 	stmt_res = (stmt_handle *) stmt->driver_data;
+	conn_res = (conn_handle *) stmt->dbh->driver_data;
 	col_res = &stmt_res->columns[colno];
 	col = &stmt->columns[colno];
 
+	col_res->temporal_mode = PDO_INFORMIX_TEMPORAL_STRING;
+	if (stmt_res->temporal_mode != PDO_INFORMIX_TEMPORAL_STRING &&
+			(col_res->data_type == SQL_TYPE_DATE || col_res->data_type == SQL_TYPE_TIMESTAMP)) {
+		return stmt_bind_temporal_column(stmt, colno TSRMLS_CC);
+	}
+
 	switch (col_res->data_type) {
+		/* in smart LOB mode the LO pointer is bound, and the stream opened from it */
+		case SQL_INFX_UDT_BLOB:
+		case SQL_INFX_UDT_CLOB:
+			if (stmt_res->smart_lob) {
+				col_res->smart_lob = 1;
+				col_res->data.str_val = emalloc(conn_res->lo_ptr_length);
+				col_res->owns_str_val = 1;
+				if (!stmt_bind_column_buffer(stmt, colno, SQL_C_BINARY,
+						col_res->data.str_val, conn_res->lo_ptr_length TSRMLS_CC)) {
+					return FALSE;
+				}
+				col_res->returned_type = PDO_PARAM_LOB;
+				col->param_type = PDO_PARAM_LOB;
+				col_res->get_col = get_col_smart_lob;
+				break;
+			}
+			/* fall through */
 		case SQL_LONGVARCHAR:
 		case SQL_LONGVARBINARY:
 		case SQL_VARBINARY:
 		case SQL_BINARY:
-		case SQL_INFX_UDT_BLOB:
-		case SQL_INFX_UDT_CLOB:
 			{
 				/* we're going to need to do getdata calls to retrieve these */
 				col_res->out_length = 0;
 				/* and this is returned as a stream */
 				col_res->returned_type = PDO_PARAM_LOB;
 				col->param_type = PDO_PARAM_LOB;
+				col_res->get_col = get_col_lob;
+			}
+			break;
+		/* BOOLEAN arrives as a single byte and goes to PHP as a boolean */
+		case SQL_BIT:
+			col_res->data.b_val = 0;
+			if (!stmt_bind_column_buffer(stmt, colno, SQL_C_BIT,
+					&col_res->data.b_val, sizeof(col_res->data.b_val) TSRMLS_CC)) {
+				return FALSE;
 			}
+			col_res->returned_type = PDO_PARAM_BOOL;
+			col->param_type = PDO_PARAM_BOOL;
+			col_res->get_col = get_col_bool;
 			break;
 		/*
 		* An extra byte is required to hold positive or negative value if the
@@ -663,6 +1736,11 @@ static int stmt_bind_column(pdo_stmt_t *stmt, int colno TSRMLS_DC)
 		case SQL_DOUBLE:
 		case SQL_DECIMAL:
 		case SQL_NUMERIC:
+		case SQL_INFX_RC_ROW:
+		case SQL_INFX_RC_COLLECTION:
+		case SQL_INFX_RC_LIST:
+		case SQL_INFX_RC_SET:
+		case SQL_INFX_RC_MULTISET:
 		default:
 			if( col_res->data_type == SQL_CHAR || col_res->data_type == SQL_VARCHAR ){
 				/* Multiply the size by 4 to handle cases where client and server code pages are different.
@@ -671,18 +1749,132 @@ static int stmt_bind_column(pdo_stmt_t *stmt, int colno TSRMLS_DC)
 			} else {
 				in_length = col_res->data_size + in_length;
 			}
-			col_res->data.str_val = (char *) emalloc(in_length+1);
-			check_stmt_allocation(col_res->data.str_val,
-					"stmt_bind_column",
-					"Unable to allocate column buffer");
-			col_res->data.str_val[in_length] = '\0';
-			rc = SQLBindCol((SQLHSTMT) stmt_res->hstmt,
-					(SQLUSMALLINT) (colno + 1), SQL_C_CHAR,
-					col_res->data.str_val, in_length,
-					(SQLLEN *) (&col_res->out_length));
-			col_res->returned_type = PDO_PARAM_STR;
-			col->param_type = PDO_PARAM_STR;
+			/*
+			* A column too wide to bind is only left unbound when the client
+			* library lets SQLGetData read it amid bound columns; otherwise
+			* it is bound whole like any other.
+			*/
+			if (stmt_res->lazy_fetch ||
+					(stmt_res->max_bind_size > 0 && in_length > stmt_res->max_bind_size &&
+					INFORMIX_GD_MIXED_OK(conn_res))) {
+				/*
+				* Too wide to bind (an LVARCHAR, say), or left for later in
+				* lazy fetch mode: read it with SQLGetData instead, into a
+				* buffer sized by the values actually seen.
+				*/
+				col_res->unbound = 1;
+				col_res->unbound_ctype = SQL_C_CHAR;
+				col_res->buffer_size = in_length < UNBOUND_BUFFER_SIZE ?
+						in_length + 1 : UNBOUND_BUFFER_SIZE;
+				col_res->data.str_val = (char *) emalloc(col_res->buffer_size);
+				check_stmt_allocation(col_res->data.str_val,
+						"stmt_bind_column",
+						"Unable to allocate column buffer");
+				col_res->owns_str_val = 1;
+				col_res->data.str_val[0] = '\0';
+			} else {
+				col_res->data.str_val = (char *) emalloc(in_length+1);
+				check_stmt_allocation(col_res->data.str_val,
+						"stmt_bind_column",
+						"Unable to allocate column buffer");
+				col_res->owns_str_val = 1;
+				col_res->data.str_val[in_length] = '\0';
+				rc = SQLBindCol((SQLHSTMT) stmt_res->hstmt,
+						(SQLUSMALLINT) (colno + 1), SQL_C_CHAR,
+						col_res->data.str_val, in_length,
+						(SQLLEN *) (&col_res->out_length));
+			}
+			if (conn_res->complex_types && INFORMIX_COMPLEX_TYPE(col_res->data_type)) {
+				/* fetched as text, handed over as arrays */
+				col_res->complex_type = stmt_column_type_name(stmt, colno TSRMLS_CC);
+				col_res->returned_type = PDO_PARAM_ZVAL;
+				col->param_type = PDO_PARAM_ZVAL;
+				col_res->get_col = get_col_complex;
+			} else {
+				col_res->returned_type = PDO_PARAM_STR;
+				col->param_type = PDO_PARAM_STR;
+				if (col_res->data_type == SQL_INTEGER || col_res->data_type == SQL_SMALLINT ||
+						col_res->data_type == SQL_INFX_BIGINT) {
+					col_res->get_col = get_col_integer_str;
+				} else {
+					col_res->get_col = get_col_str;
+				}
+			}
+	}
+	return TRUE;
+}
+
+/*
+* Read the value of an unbound column for the current row.  A text buffer
+* is doubled, or grown to the length the CLI reports, until the value fits,
+* and is kept for the rows that follow.  A value is only read once per row,
+* as PDO may ask for a column more than once.
+*/
+static int stmt_get_unbound_column(pdo_stmt_t *stmt, int colno TSRMLS_DC)
+{
+	stmt_handle *stmt_res = (stmt_handle *) stmt->driver_data;
+	column_data *col_res = &stmt_res->columns[colno];
+	SQLULEN used = 0, avail, needed;
+	SQLLEN read_len = 0;
+	SQLRETURN rc;
+	double start;
+
+	/* a failed read is not remembered, so asking again tries again */
+	if (col_res->fetch_serial == stmt_res->fetch_serial) {
+		return TRUE;
+	}
+	col_res->out_length = SQL_NULL_DATA;
+
+	if (col_res->unbound_target != NULL) {
+		INFORMIX_STATS_START(stmt_res, start);
+		PDO_INFORMIX_GETDATA_ENTRY(stmt, colno);
+		rc = SQLGetData(stmt_res->hstmt, colno + 1, col_res->unbound_ctype,
+				col_res->unbound_target, col_res->unbound_length, &read_len);
+		PDO_INFORMIX_GETDATA_RETURN(stmt, colno, (long) read_len);
+		INFORMIX_STATS_STOP(stmt_res, data_time, start, 1);
+		check_stmt_error(rc, "SQLGetData");
+		if (rc != SQL_NO_DATA) {
+			col_res->out_length = read_len;
+		}
+		col_res->fetch_serial = stmt_res->fetch_serial;
+		return TRUE;
+	}
+
+	for (;;) {
+		avail = col_res->buffer_size - used;
+		INFORMIX_STATS_START(stmt_res, start);
+		PDO_INFORMIX_GETDATA_ENTRY(stmt, colno);
+		rc = SQLGetData(stmt_res->hstmt, colno + 1, SQL_C_CHAR,
+				col_res->data.str_val + used, avail, &read_len);
+		PDO_INFORMIX_GETDATA_RETURN(stmt, colno, (long) read_len);
+		INFORMIX_STATS_STOP(stmt_res, data_time, start, 1);
+		check_stmt_error(rc, "SQLGetData");
+
+		if (rc == SQL_NO_DATA) {
+			break;
+		}
+		if (read_len == SQL_NULL_DATA) {
+			col_res->fetch_serial = stmt_res->fetch_serial;
+			return TRUE;
+		}
+		if (rc == SQL_SUCCESS_WITH_INFO &&
+				(read_len == SQL_NO_TOTAL || (SQLULEN) read_len >= avail)) {
+			/* truncated: all but the terminator's byte was filled */
+			needed = read_len == SQL_NO_TOTAL ? 0 : used + read_len + 1;
+			used += avail - 1;
+			if (needed <= col_res->buffer_size) {
+				needed = col_res->buffer_size * 2;
+			}
+			col_res->data.str_val = erealloc(col_res->data.str_val, needed);
+			col_res->buffer_size = needed;
+			continue;
+		}
+		used += read_len;
+		break;
 	}
+	col_res->data.str_val[used] = '\0';
+	col_res->out_length = used;
+	col_res->fetch_serial = stmt_res->fetch_serial;
 	return TRUE;
 }
 
@@ -691,6 +1883,7 @@ static int stmt_allocate_column_descriptors(pdo_stmt_t *stmt TSRMLS_DC)
 {
 	stmt_handle *stmt_res = (stmt_handle *) stmt->driver_data;
 	SQLSMALLINT nResultCols = 0;
+	int i;
 
 	/* not sure */
 	int rc = SQLNumResultCols((SQLHSTMT) stmt_res->hstmt, &nResultCols);
@@ -711,6 +1904,10 @@ static int stmt_allocate_column_descriptors(pdo_stmt_t *stmt TSRMLS_DC)
 	check_stmt_allocation(stmt_res->columns, "stmt_allocate_column_descriptors",
 			"Unable to allocate column descriptor tables");
 	memset(stmt_res->columns, '\0', sizeof(column_data) * stmt->column_count);
+	/* until bound, a column reads as NULL */
+	for (i = 0; i < stmt->column_count; i++) {
+		stmt_res->columns[i].get_col = get_col_str;
+	}
 	return TRUE;
 }
 
@@ -723,6 +1920,7 @@ int informix_stmt_dtor( pdo_stmt_t *stmt TSRMLS_DC)
 	stmt_handle *stmt_res = (stmt_handle *) stmt->driver_data;
 
 	if (stmt_res != NULL) {
+		informix_slow_query_check(stmt TSRMLS_CC);
 		if (stmt_res->hstmt != SQL_NULL_HANDLE) {
 			/* if we've done some work, we need to clean up. */
 			if (stmt->executed) {
@@ -742,17 +1940,19 @@ int informix_stmt_dtor( pdo_stmt_t *stmt TSRMLS_DC)
 * Execute a PDOStatement.  Used for both the PDOStatement::execute() method
 * as well as the PDO:query() method.
 */
-static int informix_stmt_executer( pdo_stmt_t * stmt TSRMLS_DC)
+static int stmt_execute( pdo_stmt_t * stmt TSRMLS_DC)
 {
 	stmt_handle *stmt_res = (stmt_handle *) stmt->driver_data;
-	int rc = 0;
+	int rc = 0, timed;
 	SQLLEN rowCount;
+	double start = 0.0, elapsed = 0.0;
 
 	/*
 	* If this statement has already been executed, then we need to
 	* cancel the previous execution before doing this again.
 	*/
 	if (stmt->executed) {
+		informix_slow_query_check(stmt TSRMLS_CC);
 		rc = SQLFreeStmt(stmt_res->hstmt, SQL_CLOSE);
 		check_stmt_error(rc, "SQLFreeStmt");
 	}
@@ -767,13 +1967,45 @@ static int informix_stmt_executer( pdo_stmt_t * stmt TSRMLS_DC)
 	clear_stmt_error(stmt);
 
 	stmt_res->lob_buffer = NULL;
+
+	/* the slow query log needs the parameters as they are now */
+	if (INFORMIX_SLOW_QUERY_ENABLED()) {
+		stmt_res->slow_params.len = 0;
+		slow_query_append_params(&stmt_res->slow_params, stmt->bound_params TSRMLS_CC);
+		smart_str_0(&stmt_res->slow_params);
+	}
+
 	/*
 	* Execute the statement.  All parameters should be bound at
 	* this point, but we might need to pump data in for some of
 	* the parameters.
 	*/
+	timed = stmt_res->collect_stats || INFORMIX_SLOW_QUERY_ENABLED();
+	if (timed) {
+		start = informix_clock();
+	}
 	rc = SQLExecute((SQLHSTMT) stmt_res->hstmt);
+	if (timed) {
+		elapsed = informix_clock() - start;
+		PDO_INFORMIX_G(execute_time) += elapsed;
+		PDO_INFORMIX_G(timed_executes)++;
+	}
+	PDO_INFORMIX_G(executes)++;
+	INFORMIX_STATS_ADD(stmt_res, execute_time, elapsed);
+	INFORMIX_STATS_ADD(stmt_res, cli_calls, 1);
+	if (rc == SQL_ERROR && INFORMIX_SLOW_QUERY_ENABLED() &&
+			elapsed * 1000.0 >= PDO_INFORMIX_G(slow_query_threshold)) {
+		informix_slow_query_log(stmt->query_string, stmt->query_stringlen,
+				stmt_res->slow_params.c, -1, elapsed, 0.0 TSRMLS_CC);
+	}
 	check_stmt_error(rc, "SQLExecute");
+
+	/* start timing this execution for the slow query log */
+	stmt_res->slow_pending = INFORMIX_SLOW_QUERY_ENABLED();
+	stmt_res->slow_execute_time = elapsed;
+	stmt_res->slow_fetch_time = 0.0;
+	/* counted whether or not the log is on; the fetch probe reports it too */
+	stmt_res->exec_rows = 0;
 	/*
 	* Now check if we have indirectly bound parameters. If we do,
 	* then we need to push the data for those parameters into the
@@ -788,8 +2020,10 @@ static int informix_stmt_executer( pdo_stmt_t * stmt TSRMLS_DC)
 		* stored a pointer to the parameter control block, so we identify
 		* which one needs data from that.
 		*/
+		INFORMIX_STATS_START(stmt_res, start);
 		while ((SQLParamData(stmt_res->hstmt, (SQLPOINTER) & param)) == SQL_NEED_DATA) {
-	
+			INFORMIX_STATS_ADD(stmt_res, cli_calls, 1);
+
 			/*
 			* OK, we have a LOB.  This is either in string form, in
 			* which case we can supply it directly, or is a PHP stream.
@@ -798,9 +2032,14 @@ static int informix_stmt_executer( pdo_stmt_t * stmt TSRMLS_DC)
 			*/
 			if (Z_TYPE_P(param->parameter) != IS_RESOURCE) {
 				convert_to_string(param->parameter);
+				PDO_INFORMIX_PUTDATA_ENTRY(stmt, Z_STRLEN_P(param->parameter));
 				rc = SQLPutData(stmt_res->hstmt, Z_STRVAL_P(param->parameter),
 						Z_STRLEN_P(param->parameter));
+				PDO_INFORMIX_PUTDATA_RETURN(stmt, Z_STRLEN_P(param->parameter), rc != SQL_ERROR);
 				check_stmt_error(rc, "SQLPutData");
+				INFORMIX_STATS_ADD(stmt_res, cli_calls, 1);
+				INFORMIX_STATS_ADD(stmt_res, lob_bytes, Z_STRLEN_P(param->parameter));
+				PDO_INFORMIX_G(lob_bytes) += Z_STRLEN_P(param->parameter);
 				continue;
 			} else {
 				/*
@@ -817,22 +2056,29 @@ static int informix_stmt_executer( pdo_stmt_t * stmt TSRMLS_DC)
 				}
 				/* allocate a buffer if we haven't prior to this */
 				if (stmt_res->lob_buffer == NULL) {
-					stmt_res->lob_buffer = emalloc(LOB_BUFFER_SIZE);
+					stmt_res->lob_buffer = emalloc(stmt_res->lob_chunk_size);
 					check_stmt_allocation(stmt_res->lob_buffer,
 						"stmt_execute", "Unable to allocate parameter data buffer");
 				}
 				/* read a buffer at a time and push into the execution pipe. */
 				for (;;) {
-					len = php_stream_read(stm, stmt_res->lob_buffer, LOB_BUFFER_SIZE);
+					len = php_stream_read(stm, stmt_res->lob_buffer, stmt_res->lob_chunk_size);
 					if (len == 0) {
 						break;
 					}
 					/* add the buffer */
+					PDO_INFORMIX_PUTDATA_ENTRY(stmt, len);
 					rc = SQLPutData(stmt_res->hstmt, stmt_res->lob_buffer, len);
+					PDO_INFORMIX_PUTDATA_RETURN(stmt, len, rc != SQL_ERROR);
 					check_stmt_error(rc, "SQLPutData");
+					INFORMIX_STATS_ADD(stmt_res, cli_calls, 1);
+					INFORMIX_STATS_ADD(stmt_res, lob_bytes, len);
+					PDO_INFORMIX_G(lob_bytes) += len;
 				}
 			}
 		}
+		/* the final SQLParamData, which completes the execution */
+		INFORMIX_STATS_STOP(stmt_res, data_time, start, 1);
 		/* Free any LOB buffer we might have */
 		if (stmt_res->lob_buffer != NULL) {
 			efree(stmt_res->lob_buffer);
@@ -847,6 +2093,7 @@ static int informix_stmt_executer( pdo_stmt_t * stmt TSRMLS_DC)
 		*/
 		rc = SQLRowCount(stmt_res->hstmt, &rowCount);
 		check_stmt_error(rc, "SQLRowCount");
+		INFORMIX_STATS_ADD(stmt_res, cli_calls, 1);
 		/* store the affected rows information. */
 		stmt->row_count = rowCount;
 	
@@ -866,12 +2113,28 @@ static int informix_stmt_executer( pdo_stmt_t * stmt TSRMLS_DC)
 
 	/* we can turn off the cleanup flag now */
 	stmt_res->executing = 0;
+	((conn_handle *) stmt->dbh->driver_data)->last_used = time(NULL);
+
+	/* without a result set there is nothing more to time */
+	if (stmt->column_count == 0) {
+		informix_slow_query_check(stmt TSRMLS_CC);
+	}
 
 	return TRUE;
 }
 
+static int informix_stmt_executer( pdo_stmt_t * stmt TSRMLS_DC)
+{
+	int rc;
+
+	PDO_INFORMIX_EXECUTE_ENTRY(stmt, stmt->query_string);
+	rc = stmt_execute(stmt TSRMLS_CC);
+	PDO_INFORMIX_EXECUTE_RETURN(stmt, (long) stmt->row_count, rc);
+	return rc;
+}
+
 /* fetch the next row of the result set. */
-static int informix_stmt_fetcher(
+static int stmt_fetch(
 	pdo_stmt_t *stmt,
 	enum pdo_fetch_orientation ori,
 	long offset
@@ -880,7 +2143,8 @@ static int informix_stmt_fetcher(
 	stmt_handle *stmt_res = (stmt_handle *) stmt->driver_data;
 	/* by default, we're just fetching the next one */
 	SQLSMALLINT direction = SQL_FETCH_NEXT;
-	int rc = 0;
+	int rc = 0, timed;
+	double start = 0.0, elapsed;
 
 	/* convert the PDO orientation information to the SQL one */
 	switch (ori) {
@@ -905,7 +2169,17 @@ static int informix_stmt_fetcher(
 	}
 
 	/* go fetch it. */
+	timed = stmt_res->collect_stats || stmt_res->slow_pending;
+	if (timed) {
+		start = informix_clock();
+	}
 	rc = SQLFetchScroll((SQLHSTMT)stmt_res->hstmt, direction, (SQLINTEGER) offset);
+	if (timed) {
+		elapsed = informix_clock() - start;
+		stmt_res->slow_fetch_time += elapsed;
+		INFORMIX_STATS_ADD(stmt_res, fetch_time, elapsed);
+		INFORMIX_STATS_ADD(stmt_res, cli_calls, 1);
+	}
 	check_stmt_error(rc, "SQLFetchScroll");
 
 	/*
@@ -921,14 +2195,35 @@ static int informix_stmt_fetcher(
 		if (stmt_res->cursor_type == PDO_CURSOR_FWDONLY) {
 			SQLCloseCursor(stmt_res->hstmt);
 		}
+		/* the whole result has been read, so the query's time is known */
+		informix_slow_query_check(stmt TSRMLS_CC);
 		return FALSE;
 	} else if (rc == SQL_ERROR) {
 		return FALSE;
 	}
 
+	INFORMIX_STATS_ADD(stmt_res, rows_fetched, 1);
+	PDO_INFORMIX_G(rows_fetched)++;
+	stmt_res->exec_rows++;
+	stmt_res->fetch_serial++;
 	return TRUE;
 }
 
+static int informix_stmt_fetcher(
+	pdo_stmt_t *stmt,
+	enum pdo_fetch_orientation ori,
+	long offset
+	TSRMLS_DC)
+{
+	int rc;
+
+	PDO_INFORMIX_FETCH_ENTRY(stmt);
+	rc = stmt_fetch(stmt, ori, offset TSRMLS_CC);
+	PDO_INFORMIX_FETCH_RETURN(stmt,
+			stmt->driver_data ? ((stmt_handle *) stmt->driver_data)->exec_rows : 0, rc);
+	return rc;
+}
+
 /* process the various bound parameter events. */
 static int informix_stmt_param_hook(
 	pdo_stmt_t *stmt,
@@ -980,8 +2275,15 @@ static int informix_stmt_param_hook(
 				break;
 			case PDO_PARAM_EVT_FETCH_PRE:
 				if (param->param_type == PDO_PARAM_LOB) {
-					(&((stmt_handle *) stmt->driver_data)->
-						columns[param->paramno])->returned_type = PDO_PARAM_LOB;
+					column_data *col_res = &((stmt_handle *) stmt->driver_data)->
+						columns[param->paramno];
+					col_res->returned_type = PDO_PARAM_LOB;
+					/* a smart LOB is already handed over as a stream */
+					if (!col_res->smart_lob) {
+						/* the stream does the reading */
+						col_res->unbound = 0;
+						col_res->get_col = get_col_lob;
+					}
 				}
 				break;
 			case PDO_PARAM_EVT_FETCH_POST:
@@ -991,6 +2293,160 @@ static int informix_stmt_param_hook(
 	return TRUE;
 }
 
+/* the concise type of a descriptor record, from its verbose type and subtype code */
+static SQLSMALLINT informix_concise_type(SQLSMALLINT type, SQLSMALLINT subtype)
+{
+	switch (type) {
+		case SQL_DATETIME:
+			return SQL_TYPE_DATE - SQL_CODE_DATE + subtype;
+		case SQL_INTERVAL:
+			return SQL_INTERVAL_YEAR - SQL_CODE_YEAR + subtype;
+		default:
+			return type;
+	}
+}
+
+/*
+* The display size of the types where it follows from the descriptor record,
+* or 0 when it has to be asked for with SQLColAttribute.  DECIMAL and
+* NUMERIC take their precision plus sign and point; a floating DECIMAL
+* (no fixed scale) is left to the driver.  The length in the record is the
+* octet length, which for the character types is not the display size once
+* a multibyte client locale is in use, so CHAR, VARCHAR, NCHAR and
+* LVARCHAR columns still cost one SQLColAttribute call each.
+*/
+static SQLULEN informix_display_size(SQLSMALLINT type, SQLSMALLINT precision, SQLSMALLINT scale)
+{
+	switch (type) {
+		case SQL_BIT:
+			return 1;
+		case SQL_SMALLINT:
+			return 6;
+		case SQL_INTEGER:
+			return 11;
+		case SQL_BIGINT:
+		case SQL_INFX_BIGINT:
+			return 20;
+		case SQL_REAL:
+			return 14;
+		case SQL_FLOAT:
+		case SQL_DOUBLE:
+			return 24;
+		case SQL_DECIMAL:
+		case SQL_NUMERIC:
+			if (precision > 0 && scale >= 0 && scale <= precision) {
+				return precision + 2;
+			}
+			return 0;
+		case SQL_TYPE_DATE:
+			return 10;
+		default:
+			return 0;
+	}
+}
+
+/*
+* Describe every column of the result, the first time PDO asks for one.
+* A single SQLGetDescRec per column on the implementation row descriptor
+* gives the name, type, scale and nullability, and for the numeric and date
+* types the display size follows from the record; the character types and
+* the rest need SQLColAttribute as well.  The names go straight to PDO, which releases them.
+* Should the descriptor not be usable, SQLDescribeCol takes over for the
+* remaining columns.
+*/
+static int stmt_describe_columns(pdo_stmt_t *stmt TSRMLS_DC)
+{
+	stmt_handle *stmt_res = (stmt_handle *) stmt->driver_data;
+	column_data *col_res;
+	struct pdo_column_data *col;
+	SQLHDESC hdesc = SQL_NULL_HANDLE;
+	char tmp_name[BUFSIZ];
+	char *name = tmp_name;
+	SQLSMALLINT name_max, type, subtype, precision;
+	SQLLEN length;
+	SQLULEN display_size;
+	int colno, use_desc, rc;
+	long calls = 1;
+	char *tag = "SQLDescribeCol";
+	double start;
+
+	INFORMIX_STATS_START(stmt_res, start);
+	rc = SQLGetStmtAttr(stmt_res->hstmt, SQL_ATTR_IMP_ROW_DESC, &hdesc, SQL_IS_POINTER, NULL);
+	use_desc = (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO);
+
+	for (colno = 0; colno < stmt->column_count; colno++) {
+		col_res = &stmt_res->columns[colno];
+		name = tmp_name;
+		name_max = BUFSIZ;
+		for (;;) {
+			display_size = 0;
+			calls++;
+			if (use_desc) {
+				rc = SQLGetDescRec(hdesc, (SQLSMALLINT) (colno + 1), (SQLCHAR *) name, name_max,
+						&col_res->namelen, &type, &subtype, &length, &precision,
+						&col_res->scale, &col_res->nullable);
+				if (rc == SQL_ERROR) {
+					use_desc = 0;
+					continue;
+				}
+				col_res->data_type = informix_concise_type(type, subtype);
+				display_size = informix_display_size(col_res->data_type, precision, col_res->scale);
+			} else {
+				rc = SQLDescribeCol((SQLHSTMT) stmt_res->hstmt, (SQLSMALLINT) (colno + 1),
+						(SQLCHAR *) name, name_max, &col_res->namelen, &col_res->data_type,
+						&col_res->data_size, &col_res->scale, &col_res->nullable);
+				if (rc == SQL_ERROR) {
+					tag = "SQLDescribeCol";
+					goto error;
+				}
+			}
+			/*
+			* If the name is too long for our buffer (which in theory should
+			* never happen), allocate a longer one and ask again.
+			*/
+			if (col_res->namelen >= name_max && name == tmp_name) {
+				name_max = col_res->namelen + 1;
+				name = emalloc(name_max);
+				continue;
+			}
+			break;
+		}
+		if (display_size == 0) {
+			calls++;
+			rc = SQLColAttribute(stmt_res->hstmt, colno + 1, SQL_DESC_DISPLAY_SIZE,
+					NULL, 0, NULL, &display_size);
+			if (rc == SQL_ERROR) {
+				tag = "SQLColAttribute";
+				goto error;
+			}
+		}
+		col_res->data_size = display_size;
+		if (col_res->namelen < 0) {
+			col_res->namelen = 0;
+		}
+
+		/* PDO releases (and may case fold) the name, so it owns it from here */
+		col = &stmt->columns[colno];
+		col->name = estrndup(name, col_res->namelen);
+		col->namelen = col_res->namelen;
+		col_res->name = col->name;
+		if (name != tmp_name) {
+			efree(name);
+		}
+	}
+	INFORMIX_STATS_STOP(stmt_res, describe_time, start, calls);
+	stmt_res->columns_described = 1;
+	return TRUE;
+
+error:
+	INFORMIX_STATS_STOP(stmt_res, describe_time, start, calls);
+	if (name != tmp_name) {
+		efree(name);
+	}
+	RAISE_STMT_ERROR(tag);
+	return FALSE;
+}
+
 /* describe a column for the PDO driver. */
 static int informix_stmt_describer(
 	pdo_stmt_t *stmt,
@@ -1000,47 +2456,14 @@ static int informix_stmt_describer(
 	stmt_handle *stmt_res = (stmt_handle *)stmt->driver_data;
 	/* access the information for this column */
 	column_data *col_res = &stmt_res->columns[colno];
-	struct pdo_column_data *col = NULL;
-	char tmp_name[BUFSIZ];
-
-	/* get the column descriptor information */
-	int rc = SQLDescribeCol((SQLHSTMT)stmt_res->hstmt, (SQLSMALLINT)(colno + 1 ),
-			tmp_name, BUFSIZ, &col_res->namelen, &col_res->data_type, &col_res->data_size,
-			&col_res->scale, &col_res->nullable);
-	check_stmt_error(rc, "SQLDescribeCol");
+	struct pdo_column_data *col = &stmt->columns[colno];
 
-	rc = SQLColAttribute(stmt_res->hstmt, colno+1, SQL_DESC_DISPLAY_SIZE,
-			NULL, 0, NULL, &col_res->data_size);
-	check_stmt_error(rc, "SQLColAttribute");
-	/*
-	* Make sure we get a name properly.  If the name is too long for our
-	* buffer (which in theory should never happen), allocate a longer one
-	* and ask for the information again.
-	*/
-	if (col_res->namelen <= 0) {
-		col_res->name = estrdup("");
-		check_stmt_allocation(col_res->name, "informix_stmt_describer",
-				"Unable to allocate column name");
-	} else if (col_res->namelen >= BUFSIZ ) {
-		/* column name is longer than BUFSIZ */
-		col_res->name = emalloc(col_res->namelen + 1);
-		check_stmt_allocation(col_res->name, "informix_stmt_describer", "Unable to allocate column name");
-		rc = SQLDescribeCol((SQLHSTMT)stmt_res->hstmt, (SQLSMALLINT)(colno + 1 ), col_res->name,
-				BUFSIZ, &col_res->namelen, &col_res->data_type, &col_res->data_size, &col_res->scale,
-				&col_res->nullable);
-		check_stmt_error(rc, "SQLDescribeCol");
-	} else {
-		col_res->name = estrdup(tmp_name);
-		check_stmt_allocation(col_res->name, "informix_stmt_describer", "Unable to allocate column name");
+	/* the first call describes them all, names included */
+	if (!stmt_res->columns_described && !stmt_describe_columns(stmt TSRMLS_CC)) {
+		return FALSE;
 	}
-	col = &stmt->columns[colno];
 
-	/*
-	* Copy the information back into the PDO control block.  Note that
-	* PDO will release the name information, so we don't have to.
-	*/
-	col->name = col_res->name;
-	col->namelen = col_res->namelen;
+	/* copy the rest of the information back into the PDO control block */
 	col->maxlen = col_res->data_size;
 	col->precision = col_res->scale;
 
@@ -1051,7 +2474,8 @@ static int informix_stmt_describer(
 
 /*
 * Fetch the data for a specific column.  This should be sitting in our
-* allocated buffer already, and easy to return.
+* allocated buffer already (unless the column is read on demand), and is
+* returned by the accessor chosen for the column when it was bound.
 */
 static int informix_stmt_get_col(
 	pdo_stmt_t *stmt,
@@ -1064,61 +2488,27 @@ static int informix_stmt_get_col(
 	stmt_handle *stmt_res = (stmt_handle *) stmt->driver_data;
 	/* access our look aside data */
 	column_data *col_res = &stmt_res->columns[colno];
+	int i;
 
-	if (col_res->returned_type == PDO_PARAM_LOB) {
-		php_stream *stream = create_lob_stream(stmt, stmt_res, colno TSRMLS_CC);	/* already opened */
-		if (stream != NULL) {
-			*ptr = (char *) stream;
-		} else {
-			*ptr = NULL;
+	if (col_res->unbound) {
+		/*
+		* Without SQL_GD_ANY_ORDER a column cannot be read once a later one
+		* has been, so the unbound columns in front of this one are read
+		* (and kept for the row) first.
+		*/
+		if (stmt_res->getdata_ordered) {
+			for (i = 0; i < colno; i++) {
+				if (stmt_res->columns[i].unbound &&
+						!stmt_get_unbound_column(stmt, i TSRMLS_CC)) {
+					return 0;
+				}
+			}
 		}
-		*len = 0;
-	}
-	/* see if this is a null value */
-	else if (col_res->out_length == SQL_NULL_DATA) {
-		/* return this as a real null */
-		*ptr = NULL;
-		*len = 0;
-	}
-	/* see if length is SQL_NTS ("count the length yourself"-value) */
-	else if (col_res->out_length == SQL_NTS) {
-		if (col_res->data.str_val && col_res->data.str_val[0] != '\0') {
-			/* it's not an empty string */
-			*ptr = col_res->data.str_val;
-			*len = strlen(col_res->data.str_val);
-		} else if (col_res->data.str_val && col_res->data.str_val[0] == '\0') {
-			/* it's an empty string */
-			*ptr = col_res->data.str_val;
-			*len = 0;
-		} else {
-			/* it's NULL */
-			*ptr = NULL;
-			*len = 0;
+		if (!stmt_get_unbound_column(stmt, colno TSRMLS_CC)) {
+			return 0;
 		}
 	}
-	/* string type...very common */
-	else if (col_res->returned_type == PDO_PARAM_STR) {
-		/* set the info */
-        switch(col_res->data_type) {
-            case SQL_INTEGER:
-            case SQL_SMALLINT:
-            case SQL_INFX_BIGINT:
-                if (col_res->out_length > 20) {
-                    *ptr = NULL;
-                    *len = 0;
-                    break;
-                }
-            default:
-                *ptr = col_res->data.str_val;
-                *len = col_res->out_length;
-        }
-	} else {
-	/* binary numeric form */
-		*ptr = (char *) &col_res->data.l_val;
-		*len = col_res->out_length;
-	}
-
-	return TRUE;
+	return col_res->get_col(stmt, colno, col_res, ptr, len TSRMLS_CC);
 }
 
 /* step to the next result set of the query. */
@@ -1235,7 +2625,7 @@ static int informix_stmt_get_column_meta(
 
 #define CURSOR_NAME_BUFFER_LENGTH 256
 
-/* get driver specific attributes.  We only support CURSOR_NAME. */
+/* get driver specific attributes: CURSOR_NAME, the statistics and the tunables. */
 static int informix_stmt_get_attribute(
 	pdo_stmt_t *stmt,
 	long attr,
@@ -1259,6 +2649,40 @@ static int informix_stmt_get_attribute(
 			ZVAL_STRINGL(return_value, buffer, length, 1);
 			return TRUE;
 		}
+		case PDO_INFORMIX_ATTR_STATS:
+		{
+			informix_stmt_stats *stats = &stmt_res->stats;
+
+			array_init(return_value);
+			add_assoc_bool(return_value, "enabled", stmt_res->collect_stats);
+			add_assoc_double(return_value, "prepare_time", stats->prepare_time);
+			add_assoc_double(return_value, "execute_time", stats->execute_time);
+			add_assoc_double(return_value, "fetch_time", stats->fetch_time);
+			add_assoc_double(return_value, "data_time", stats->data_time);
+			add_assoc_double(return_value, "describe_time", stats->describe_time);
+			add_assoc_long(return_value, "cli_calls", stats->cli_calls);
+			add_assoc_long(return_value, "rows_fetched", stats->rows_fetched);
+			add_assoc_long(return_value, "lob_bytes", stats->lob_bytes);
+			return TRUE;
+		}
+		case PDO_INFORMIX_ATTR_LOB_CHUNK_SIZE:
+			ZVAL_LONG(return_value, stmt_res->lob_chunk_size);
+			return TRUE;
+		case PDO_INFORMIX_ATTR_QUERY_TIMEOUT:
+			ZVAL_LONG(return_value, stmt_res->query_timeout);
+			return TRUE;
+		case PDO_INFORMIX_ATTR_TEMPORAL_MODE:
+			ZVAL_LONG(return_value, stmt_res->temporal_mode);
+			return TRUE;
+		case PDO_INFORMIX_ATTR_LOB_WRITABLE:
+			ZVAL_BOOL(return_value, stmt_res->lob_writable);
+			return TRUE;
+		case PDO_INFORMIX_ATTR_MAX_BIND_SIZE:
+			ZVAL_LONG(return_value, stmt_res->max_bind_size);
+			return TRUE;
+		case PDO_INFORMIX_ATTR_LAZY_FETCH:
+			ZVAL_BOOL(return_value, stmt_res->lazy_fetch);
+			return TRUE;
 		/* unknown attribute */
 		default:
 		{
@@ -1270,7 +2694,7 @@ static int informix_stmt_get_attribute(
 	}
 }
 
-/* set a driver-specific attribute.  We only support CURSOR_NAME. */
+/* set a driver-specific attribute: CURSOR_NAME, statistics collection or a tunable. */
 static int informix_stmt_set_attribute(
 	pdo_stmt_t *stmt,
 	long attr,
@@ -1290,6 +2714,66 @@ static int informix_stmt_set_attribute(
 			check_stmt_error(rc, "SQLSetCursorName");
 			return TRUE;
 		}
+		case PDO_INFORMIX_ATTR_STATS:
+		{
+			/* switching collection on starts the counters afresh */
+			int enable = zend_is_true(value);
+			if (enable && !stmt_res->collect_stats) {
+				memset(&stmt_res->stats, 0, sizeof(stmt_res->stats));
+			}
+			stmt_res->collect_stats = enable;
+			return TRUE;
+		}
+		case PDO_INFORMIX_ATTR_LOB_CHUNK_SIZE:
+			convert_to_long(value);
+			if (Z_LVAL_P(value) <= 0) {
+				RAISE_INFORMIX_STMT_ERROR("HY024", "setAttribute",
+					"The LOB chunk size must be positive");
+				return FALSE;
+			}
+			/* the parameter buffer is sized per execution, so this is safe any time */
+			stmt_res->lob_chunk_size = Z_LVAL_P(value);
+			return TRUE;
+		case PDO_INFORMIX_ATTR_QUERY_TIMEOUT:
+			convert_to_long(value);
+			if (Z_LVAL_P(value) < 0) {
+				RAISE_INFORMIX_STMT_ERROR("HY024", "setAttribute",
+					"The query timeout cannot be negative");
+				return FALSE;
+			}
+			rc = SQLSetStmtAttr(stmt_res->hstmt, SQL_ATTR_QUERY_TIMEOUT,
+					(SQLPOINTER) Z_LVAL_P(value), 0);
+			check_stmt_error(rc, "SQLSetStmtAttr");
+			stmt_res->query_timeout = Z_LVAL_P(value);
+			return TRUE;
+		case PDO_INFORMIX_ATTR_TEMPORAL_MODE:
+			convert_to_long(value);
+			if (!INFORMIX_TEMPORAL_MODE_VALID(Z_LVAL_P(value))) {
+				RAISE_INFORMIX_STMT_ERROR("HY024", "setAttribute",
+					"Invalid temporal mode");
+				return FALSE;
+			}
+			/* applies to result sets described from now on */
+			stmt_res->temporal_mode = (int) Z_LVAL_P(value);
+			return TRUE;
+		case PDO_INFORMIX_ATTR_MAX_BIND_SIZE:
+			convert_to_long(value);
+			if (Z_LVAL_P(value) < 0) {
+				RAISE_INFORMIX_STMT_ERROR("HY024", "setAttribute",
+					"The maximum bind size cannot be negative");
+				return FALSE;
+			}
+			/* applies to result sets described from now on */
+			stmt_res->max_bind_size = Z_LVAL_P(value);
+			return TRUE;
+		case PDO_INFORMIX_ATTR_LAZY_FETCH:
+			/* applies to result sets described from now on */
+			stmt_res->lazy_fetch = zend_is_true(value);
+			return TRUE;
+		case PDO_INFORMIX_ATTR_LOB_WRITABLE:
+			/* applies to smart LOB streams opened from now on */
+			stmt_res->lob_writable = zend_is_true(value);
+			return TRUE;
 		default:
 		{
 			/* raise a driver error, and give the special -1 return. */
@@ -0,0 +1,295 @@
+/*
+  +----------------------------------------------------------------------+
+  | (C) Copyright IBM Corporation 2006.                                  |
+  +----------------------------------------------------------------------+
+  |                                                                      |
+  | Licensed under the Apache License, Version 2.0 (the "License"); you  |
+  | may not use this file except in compliance with the License. You may |
+  | obtain a copy of the License at                                      |
+  | http://www.apache.org/licenses/LICENSE-2.0                           |
+  |                                                                      |
+  | Unless required by applicable law or agreed to in writing, software  |
+  | distributed under the License is distributed on an "AS IS" BASIS,    |
+  | WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or      |
+  | implied. See the License for the specific language governing         |
+  | permissions and limitations under the License.                       |
+  +----------------------------------------------------------------------+
+*/
+
+/*
+* Stand-in for the Informix CLI header, used when the driver is built with
+* --enable-pdo-informix-mock.  It declares only the subset of the CLI the
+* driver calls, with the standard ODBC values, so that the extension can be
+* built and benchmarked on a machine without the Client SDK.  The functions
+* are implemented in-memory by mock_cli.c.
+*/
+
+#ifndef PDO_INFORMIX_MOCK_INFXCLI_H
+#define PDO_INFORMIX_MOCK_INFXCLI_H
+
+#include <stddef.h>
+
+typedef unsigned char		SQLCHAR;
+typedef unsigned char		UCHAR;
+typedef short				SQLSMALLINT;
+typedef unsigned short		SQLUSMALLINT;
+typedef int					SQLINTEGER;
+typedef unsigned int		SQLUINTEGER;
+typedef long				SQLLEN;
+typedef unsigned long		SQLULEN;
+typedef void *				SQLPOINTER;
+typedef SQLSMALLINT			SQLRETURN;
+typedef void *				SQLHANDLE;
+typedef SQLHANDLE			SQLHENV;
+typedef SQLHANDLE			SQLHDBC;
+typedef SQLHANDLE			SQLHSTMT;
+typedef SQLHANDLE			SQLHDESC;
+typedef void *				SQLHWND;
+
+/* return codes */
+#define SQL_SUCCESS					0
+#define SQL_SUCCESS_WITH_INFO		1
+#define SQL_NEED_DATA				99
+#define SQL_NO_DATA					100
+#define SQL_NO_DATA_FOUND			SQL_NO_DATA
+#define SQL_ERROR					(-1)
+#define SQL_INVALID_HANDLE			(-2)
+
+/* handles */
+#define SQL_NULL_HANDLE				0L
+#define SQL_HANDLE_ENV				1
+#define SQL_HANDLE_DBC				2
+#define SQL_HANDLE_STMT				3
+#define SQL_HANDLE_DESC				4
+
+/* lengths and indicators */
+#define SQL_NTS						(-3)
+#define SQL_NULL_DATA				(-1)
+#define SQL_NO_TOTAL				(-4)
+#define SQL_DATA_AT_EXEC			(-2)
+#define SQL_LEN_DATA_AT_EXEC_OFFSET	(-100)
+#define SQL_LEN_DATA_AT_EXEC(length)	(-(length) + SQL_LEN_DATA_AT_EXEC_OFFSET)
+#define SQL_IS_POINTER				(-4)
+#define SQL_IS_UINTEGER				(-5)
+#define SQL_IS_INTEGER				(-6)
+#define SQL_IS_USMALLINT			(-7)
+#define SQL_IS_SMALLINT				(-8)
+#define SQL_MAX_MESSAGE_LENGTH		512
+#define SQL_SQLSTATE_SIZE			5
+#define SQL_TRUE					1
+#define SQL_FALSE					0
+
+/* environment and connection attributes */
+#define SQL_ATTR_ODBC_VERSION		200
+#define SQL_OV_ODBC3				3UL
+#define SQL_ATTR_AUTOCOMMIT			102
+#define SQL_AUTOCOMMIT_OFF			0UL
+#define SQL_AUTOCOMMIT_ON			1UL
+#define SQL_ATTR_TXN_ISOLATION		108
+#define SQL_TXN_READ_UNCOMMITTED	1L
+#define SQL_TXN_READ_COMMITTED		2L
+#define SQL_TXN_REPEATABLE_READ		4L
+#define SQL_TXN_SERIALIZABLE		8L
+#define SQL_ATTR_CONNECTION_DEAD	1209
+#define SQL_CD_TRUE					1L
+#define SQL_CD_FALSE				0L
+#define SQL_DRIVER_NOPROMPT			0
+
+/* Informix specific attributes */
+#define SQL_INFX_ATTR_LO_AUTOMATIC		2262
+#define SQL_INFX_ATTR_ODBC_TYPES_ONLY	2263
+#define SQL_GET_SERIAL_VALUE			2251
+#define SQL_INFX_LO_PTR_LENGTH			2254	/* SQLGetInfo: size of an LO pointer */
+
+/* statement attributes */
+#define SQL_ATTR_QUERY_TIMEOUT		0
+#define SQL_ATTR_CURSOR_TYPE		6
+#define SQL_ATTR_IMP_ROW_DESC		10012
+#define SQL_CURSOR_FORWARD_ONLY		0UL
+#define SQL_CURSOR_KEYSET_DRIVEN	1UL
+#define SQL_CURSOR_DYNAMIC			2UL
+#define SQL_CURSOR_STATIC			3UL
+
+/* SQLFreeStmt options */
+#define SQL_CLOSE					0
+#define SQL_DROP					1
+#define SQL_UNBIND					2
+#define SQL_RESET_PARAMS			3
+
+/* SQLEndTran */
+#define SQL_COMMIT					0
+#define SQL_ROLLBACK				1
+
+/* SQLFetchScroll orientations */
+#define SQL_FETCH_NEXT				1
+#define SQL_FETCH_FIRST				2
+#define SQL_FETCH_LAST				3
+#define SQL_FETCH_PRIOR				4
+#define SQL_FETCH_ABSOLUTE			5
+#define SQL_FETCH_RELATIVE			6
+
+/* SQLGetInfo */
+#define SQL_DBMS_NAME				17
+#define SQL_DBMS_VER				18
+#define SQL_GETDATA_EXTENSIONS		81
+
+/* SQL_GETDATA_EXTENSIONS bits */
+#define SQL_GD_ANY_COLUMN			0x00000001L
+#define SQL_GD_ANY_ORDER			0x00000002L
+#define SQL_GD_BLOCK				0x00000004L
+#define SQL_GD_BOUND				0x00000008L
+
+/* parameter directions */
+#define SQL_PARAM_INPUT				1
+#define SQL_PARAM_INPUT_OUTPUT		2
+#define SQL_PARAM_OUTPUT			4
+
+/* column attributes */
+#define SQL_DESC_DISPLAY_SIZE		6
+#define SQL_DESC_UNSIGNED			8
+#define SQL_DESC_AUTO_UNIQUE_VALUE	11
+#define SQL_DESC_TYPE_NAME			14
+#define SQL_DESC_BASE_TABLE_NAME	23
+
+/* diagnostics */
+#define SQL_DIAG_DYNAMIC_FUNCTION_CODE	12
+#define SQL_DIAG_INSERT					50
+#define SQL_DIAG_SELECT_CURSOR			85
+
+/* SQL data types */
+#define SQL_CHAR					1
+#define SQL_NUMERIC					2
+#define SQL_DECIMAL					3
+#define SQL_INTEGER					4
+#define SQL_SMALLINT				5
+#define SQL_FLOAT					6
+#define SQL_REAL					7
+#define SQL_DOUBLE					8
+#define SQL_VARCHAR					12
+#define SQL_TYPE_DATE				91
+#define SQL_TYPE_TIME				92
+#define SQL_TYPE_TIMESTAMP			93
+#define SQL_LONGVARCHAR				(-1)
+#define SQL_BINARY					(-2)
+#define SQL_VARBINARY				(-3)
+#define SQL_LONGVARBINARY			(-4)
+#define SQL_BIGINT					(-5)
+#define SQL_BIT						(-7)
+#define SQL_INTERVAL_YEAR			101
+#define SQL_INTERVAL_MONTH			102
+#define SQL_INTERVAL_DAY			103
+#define SQL_INTERVAL_HOUR			104
+#define SQL_INTERVAL_MINUTE			105
+#define SQL_INTERVAL_SECOND			106
+#define SQL_INTERVAL_YEAR_TO_MONTH	107
+#define SQL_INTERVAL_DAY_TO_HOUR	108
+#define SQL_INTERVAL_DAY_TO_MINUTE	109
+#define SQL_INTERVAL_DAY_TO_SECOND	110
+#define SQL_INTERVAL_HOUR_TO_MINUTE	111
+#define SQL_INTERVAL_HOUR_TO_SECOND	112
+#define SQL_INTERVAL_MINUTE_TO_SECOND	113
+
+/* verbose types and subtype codes, as found in descriptors */
+#define SQL_DATETIME				9
+#define SQL_INTERVAL				10
+#define SQL_CODE_DATE				1
+#define SQL_CODE_TIME				2
+#define SQL_CODE_TIMESTAMP			3
+#define SQL_CODE_YEAR				1
+#define SQL_INFX_UDT_FIXED			(-100)
+#define SQL_INFX_UDT_BLOB			(-102)
+#define SQL_INFX_UDT_CLOB			(-103)
+#define SQL_INFX_RC_ROW				(-105)
+#define SQL_INFX_RC_COLLECTION		(-106)
+#define SQL_INFX_RC_LIST			(-107)
+#define SQL_INFX_RC_SET				(-108)
+#define SQL_INFX_RC_MULTISET		(-109)
+#define SQL_INFX_BIGINT				(-114)
+
+/* C data types */
+#define SQL_C_CHAR					SQL_CHAR
+#define SQL_C_LONG					SQL_INTEGER
+#define SQL_C_BINARY				SQL_BINARY
+#define SQL_C_BIT					SQL_BIT
+#define SQL_C_TYPE_DATE				SQL_TYPE_DATE
+#define SQL_C_TYPE_TIME				SQL_TYPE_TIME
+#define SQL_C_TYPE_TIMESTAMP		SQL_TYPE_TIMESTAMP
+
+typedef struct tagDATE_STRUCT {
+	SQLSMALLINT year;
+	SQLUSMALLINT month;
+	SQLUSMALLINT day;
+} DATE_STRUCT;
+
+typedef struct tagTIMESTAMP_STRUCT {
+	SQLSMALLINT year;
+	SQLUSMALLINT month;
+	SQLUSMALLINT day;
+	SQLUSMALLINT hour;
+	SQLUSMALLINT minute;
+	SQLUSMALLINT second;
+	SQLUINTEGER fraction;		/* nanoseconds */
+} TIMESTAMP_STRUCT;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+SQLRETURN SQLAllocHandle(SQLSMALLINT type, SQLHANDLE input, SQLHANDLE *output);
+SQLRETURN SQLFreeHandle(SQLSMALLINT type, SQLHANDLE handle);
+SQLRETURN SQLSetEnvAttr(SQLHENV henv, SQLINTEGER attr, SQLPOINTER value, SQLINTEGER len);
+SQLRETURN SQLConnect(SQLHDBC hdbc, SQLCHAR *dsn, SQLSMALLINT dsn_len, SQLCHAR *uid,
+	SQLSMALLINT uid_len, SQLCHAR *pwd, SQLSMALLINT pwd_len);
+SQLRETURN SQLDriverConnect(SQLHDBC hdbc, SQLHWND hwnd, SQLCHAR *in, SQLSMALLINT in_len,
+	SQLCHAR *out, SQLSMALLINT out_max, SQLSMALLINT *out_len, SQLUSMALLINT completion);
+SQLRETURN SQLDisconnect(SQLHDBC hdbc);
+SQLRETURN SQLSetConnectAttr(SQLHDBC hdbc, SQLINTEGER attr, SQLPOINTER value, SQLINTEGER len);
+SQLRETURN SQLGetConnectAttr(SQLHDBC hdbc, SQLINTEGER attr, SQLPOINTER value, SQLINTEGER max,
+	SQLINTEGER *len);
+SQLRETURN SQLGetInfo(SQLHDBC hdbc, SQLUSMALLINT type, SQLPOINTER value, SQLSMALLINT max,
+	SQLSMALLINT *len);
+SQLRETURN SQLEndTran(SQLSMALLINT type, SQLHANDLE handle, SQLSMALLINT completion);
+SQLRETURN SQLPrepare(SQLHSTMT hstmt, SQLCHAR *sql, SQLINTEGER len);
+SQLRETURN SQLExecute(SQLHSTMT hstmt);
+SQLRETURN SQLExecDirect(SQLHSTMT hstmt, SQLCHAR *sql, SQLINTEGER len);
+SQLRETURN SQLParamData(SQLHSTMT hstmt, SQLPOINTER *value);
+SQLRETURN SQLPutData(SQLHSTMT hstmt, SQLPOINTER data, SQLLEN len);
+SQLRETURN SQLNumResultCols(SQLHSTMT hstmt, SQLSMALLINT *count);
+SQLRETURN SQLRowCount(SQLHSTMT hstmt, SQLLEN *count);
+SQLRETURN SQLMoreResults(SQLHSTMT hstmt);
+SQLRETURN SQLDescribeCol(SQLHSTMT hstmt, SQLUSMALLINT col, SQLCHAR *name, SQLSMALLINT max,
+	SQLSMALLINT *name_len, SQLSMALLINT *type, SQLULEN *size, SQLSMALLINT *scale,
+	SQLSMALLINT *nullable);
+SQLRETURN SQLColAttribute(SQLHSTMT hstmt, SQLUSMALLINT col, SQLUSMALLINT field,
+	SQLPOINTER char_value, SQLSMALLINT max, SQLSMALLINT *len, SQLPOINTER num_value);
+SQLRETURN SQLGetDescRec(SQLHDESC hdesc, SQLSMALLINT rec, SQLCHAR *name, SQLSMALLINT max,
+	SQLSMALLINT *name_len, SQLSMALLINT *type, SQLSMALLINT *subtype, SQLLEN *length,
+	SQLSMALLINT *precision, SQLSMALLINT *scale, SQLSMALLINT *nullable);
+SQLRETURN SQLDescribeParam(SQLHSTMT hstmt, SQLUSMALLINT param, SQLSMALLINT *type,
+	SQLULEN *size, SQLSMALLINT *scale, SQLSMALLINT *nullable);
+SQLRETURN SQLBindParameter(SQLHSTMT hstmt, SQLUSMALLINT param, SQLSMALLINT io_type,
+	SQLSMALLINT c_type, SQLSMALLINT sql_type, SQLULEN size, SQLSMALLINT scale,
+	SQLPOINTER value, SQLLEN max, SQLLEN *ind);
+SQLRETURN SQLBindCol(SQLHSTMT hstmt, SQLUSMALLINT col, SQLSMALLINT c_type, SQLPOINTER value,
+	SQLLEN max, SQLLEN *ind);
+SQLRETURN SQLFetchScroll(SQLHSTMT hstmt, SQLSMALLINT orientation, SQLLEN offset);
+SQLRETURN SQLGetData(SQLHSTMT hstmt, SQLUSMALLINT col, SQLSMALLINT c_type, SQLPOINTER value,
+	SQLLEN max, SQLLEN *ind);
+SQLRETURN SQLFreeStmt(SQLHSTMT hstmt, SQLUSMALLINT option);
+SQLRETURN SQLCloseCursor(SQLHSTMT hstmt);
+SQLRETURN SQLCancel(SQLHSTMT hstmt);
+SQLRETURN SQLSetStmtAttr(SQLHSTMT hstmt, SQLINTEGER attr, SQLPOINTER value, SQLINTEGER len);
+SQLRETURN SQLGetStmtAttr(SQLHSTMT hstmt, SQLINTEGER attr, SQLPOINTER value, SQLINTEGER max,
+	SQLINTEGER *len);
+SQLRETURN SQLSetCursorName(SQLHSTMT hstmt, SQLCHAR *name, SQLSMALLINT len);
+SQLRETURN SQLGetCursorName(SQLHSTMT hstmt, SQLCHAR *name, SQLSMALLINT max, SQLSMALLINT *len);
+SQLRETURN SQLGetDiagRec(SQLSMALLINT type, SQLHANDLE handle, SQLSMALLINT rec, SQLCHAR *state,
+	SQLINTEGER *native, SQLCHAR *msg, SQLSMALLINT max, SQLSMALLINT *len);
+SQLRETURN SQLGetDiagField(SQLSMALLINT type, SQLHANDLE handle, SQLSMALLINT rec,
+	SQLSMALLINT field, SQLPOINTER value, SQLSMALLINT max, SQLSMALLINT *len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* PDO_INFORMIX_MOCK_INFXCLI_H */
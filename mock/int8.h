@@ -0,0 +1,46 @@
+/*
+  +----------------------------------------------------------------------+
+  | (C) Copyright IBM Corporation 2006.                                  |
+  +----------------------------------------------------------------------+
+  |                                                                      |
+  | Licensed under the Apache License, Version 2.0 (the "License"); you  |
+  | may not use this file except in compliance with the License. You may |
+  | obtain a copy of the License at                                      |
+  | http://www.apache.org/licenses/LICENSE-2.0                           |
+  |                                                                      |
+  | Unless required by applicable law or agreed to in writing, software  |
+  | distributed under the License is distributed on an "AS IS" BASIS,    |
+  | WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or      |
+  | implied. See the License for the specific language governing         |
+  | permissions and limitations under the License.                       |
+  +----------------------------------------------------------------------+
+*/
+
+/*
+* Stand-in for the ESQL/C int8.h, with the part of the INT8 API the driver
+* uses for smart large object offsets.  Implemented by mock_cli.c.
+*/
+
+#ifndef PDO_INFORMIX_MOCK_INT8_H
+#define PDO_INFORMIX_MOCK_INT8_H
+
+#define INT8SIZE 2
+
+/* magnitude in two 32 bit halves, low half first; sign 1 or -1, 0 for null */
+typedef struct ifx_int8 {
+	unsigned int data[INT8SIZE];
+	short sign;
+} ifx_int8_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int ifx_int8cvdbl(double value, ifx_int8_t *int8);
+int ifx_int8todbl(ifx_int8_t *int8, double *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* PDO_INFORMIX_MOCK_INT8_H */
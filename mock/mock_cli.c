@@ -0,0 +1,1477 @@
+/*
+  +----------------------------------------------------------------------+
+  | (C) Copyright IBM Corporation 2006.                                  |
+  +----------------------------------------------------------------------+
+  |                                                                      |
+  | Licensed under the Apache License, Version 2.0 (the "License"); you  |
+  | may not use this file except in compliance with the License. You may |
+  | obtain a copy of the License at                                      |
+  | http://www.apache.org/licenses/LICENSE-2.0                           |
+  |                                                                      |
+  | Unless required by applicable law or agreed to in writing, software  |
+  | distributed under the License is distributed on an "AS IS" BASIS,    |
+  | WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or      |
+  | implied. See the License for the specific language governing         |
+  | permissions and limitations under the License.                       |
+  +----------------------------------------------------------------------+
+*/
+
+/*
+* In-memory implementation of the CLI subset used by the driver.  Nothing
+* is sent anywhere: SELECT statements produce a synthetic result set and
+* every other statement succeeds, affecting one row.  This makes it possible
+* to measure the cost of the driver itself, without a server or network in
+* the way.
+*
+* The shape of a result set comes from the environment:
+*
+*   PDO_INFORMIX_MOCK_ROWS    number of rows (default 100)
+*   PDO_INFORMIX_MOCK_TYPES   one letter per column (default "is")
+*   PDO_INFORMIX_MOCK_WIDTH   width of the character columns (default 32)
+*   PDO_INFORMIX_MOCK_LOB     size of each LOB value in bytes (default 4096)
+*
+* and can be overridden per statement with a brace comment in the SQL text:
+*
+*   SELECT {mock rows=1000 types=iisc width=64 lob=65536} ...
+*
+* where "fill=N" makes the character values N bytes long, short of the
+* declared width.
+*
+* The column type letters are i (INTEGER), s (VARCHAR), f (DOUBLE), l (BOOLEAN),
+* d (DATE), t (DATETIME YEAR TO FRACTION), c (CLOB), b (BLOB), m (MULTISET)
+* and r (ROW).  A "cols=N" setting
+* repeats the type letters until there are N columns.  Any statement that
+* mentions no_such_table fails with SQLSTATE 42S02, so that error paths can
+* be exercised too.
+*
+* Unless NeedODBCTypesOnly is set on the connection, CLOB, BLOB, MULTISET
+* and ROW columns are described with the Informix types.  Without automatic
+* LO transfer, which a statement takes from its connection when allocated
+* unless it is set on the statement itself, CLOB and BLOB values are bound
+* as LO pointers, which the ifx_lo_open/read/write/seek/close escapes then
+* work on.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "infxcli.h"
+#include "int8.h"
+
+#define MOCK_MAX_COLS	256
+#define MOCK_MAX_PARAMS	256
+#define MOCK_MAX_LOS	64
+#define MOCK_LO_PTR_LENGTH	72
+
+/* the ESQL/C smart large object open modes and seek origins */
+#define LO_RDWR			0x08
+#define LO_SEEK_CUR		1
+#define LO_SEEK_END		2
+
+enum { MOCK_ENV = 1, MOCK_DBC, MOCK_STMT, MOCK_DESC };
+
+typedef struct {
+	char state[SQL_SQLSTATE_SIZE + 1];
+	SQLINTEGER native;
+	char msg[SQL_MAX_MESSAGE_LENGTH];
+	int set;
+} mock_diag;
+
+/* every handle starts with its kind and diagnostics */
+typedef struct {
+	int kind;
+	mock_diag diag;
+} mock_handle;
+
+typedef struct {
+	int kind;
+	mock_diag diag;
+} mock_env;
+
+/* what an LO pointer of the mock holds: where the synthetic value came from */
+typedef struct {
+	char magic[8];
+	long row;
+	int col;
+	long size;
+} mock_locator;
+
+/* an open smart large object; data is only materialized by a write */
+typedef struct {
+	int open;
+	mock_locator loc;
+	long pos;
+	int writable;
+	char *data;
+} mock_lo;
+
+typedef struct {
+	int kind;
+	mock_diag diag;
+	int connected;
+	SQLUINTEGER autocommit;
+	SQLINTEGER isolation;
+	SQLINTEGER serial;
+	int odbc_types_only;
+	int lo_automatic;
+	mock_lo los[MOCK_MAX_LOS];
+} mock_dbc;
+
+typedef struct {
+	SQLSMALLINT ctype;
+	SQLPOINTER value;
+	SQLLEN max;
+	SQLLEN *ind;
+} mock_bind;
+
+typedef struct {
+	long rows;
+	int cols;
+	int width;
+	int fill;					/* length of the character values, 0 for the full width */
+	long lob_size;
+	long affected;
+	char types[MOCK_MAX_COLS + 1];
+} mock_shape;
+
+/* the implementation row descriptor of a statement */
+typedef struct {
+	int kind;
+	mock_diag diag;
+	void *stmt;
+} mock_desc;
+
+typedef struct {
+	int kind;
+	mock_diag diag;
+	mock_dbc *dbc;
+	mock_desc ird;
+
+	char *sql;					/* prepared or directly executed text */
+	const char *segment;		/* statement of the text being processed */
+	int segment_len;
+	int is_select;
+	int is_insert;
+	mock_shape shape;
+
+	int executed;
+	int need_data;				/* index of the param SQLParamData is on, -1 before the first */
+	long cursor;				/* current row, 1 based; 0 before the first row */
+	long row_count;
+
+	int getdata_col;			/* column SQLGetData last read */
+	long getdata_offset;		/* bytes of that column already returned */
+
+	SQLULEN cursor_type;
+	char cursor_name[64];
+	int lo_automatic;			/* taken from the connection when allocated */
+
+	mock_bind cols[MOCK_MAX_COLS];
+	mock_bind params[MOCK_MAX_PARAMS];
+	int nparams;
+} mock_stmt;
+
+static mock_shape mock_default_shape;
+static int mock_defaults_loaded = 0;
+
+static void mock_set_diag(void *handle, const char *state, SQLINTEGER native, const char *msg)
+{
+	mock_diag *diag = &((mock_handle *) handle)->diag;
+
+	strncpy(diag->state, state, SQL_SQLSTATE_SIZE);
+	diag->state[SQL_SQLSTATE_SIZE] = '\0';
+	diag->native = native;
+	strncpy(diag->msg, msg, sizeof(diag->msg) - 1);
+	diag->msg[sizeof(diag->msg) - 1] = '\0';
+	diag->set = 1;
+}
+
+static void mock_clear_diag(void *handle)
+{
+	((mock_handle *) handle)->diag.set = 0;
+}
+
+static long mock_env_long(const char *name, long dflt)
+{
+	const char *value = getenv(name);
+	return (value != NULL && *value != '\0') ? atol(value) : dflt;
+}
+
+static void mock_fill_types(mock_shape *shape, const char *letters, int len, int cols)
+{
+	int i;
+
+	if (len <= 0) {
+		letters = "is";
+		len = 2;
+	}
+	if (cols <= 0) {
+		cols = len;
+	}
+	if (cols > MOCK_MAX_COLS) {
+		cols = MOCK_MAX_COLS;
+	}
+	for (i = 0; i < cols; i++) {
+		shape->types[i] = letters[i % len];
+	}
+	shape->types[cols] = '\0';
+	shape->cols = cols;
+}
+
+static void mock_load_defaults(void)
+{
+	const char *types;
+
+	if (mock_defaults_loaded) {
+		return;
+	}
+	mock_default_shape.rows = mock_env_long("PDO_INFORMIX_MOCK_ROWS", 100);
+	mock_default_shape.width = (int) mock_env_long("PDO_INFORMIX_MOCK_WIDTH", 32);
+	mock_default_shape.lob_size = mock_env_long("PDO_INFORMIX_MOCK_LOB", 4096);
+	mock_default_shape.affected = 1;
+	types = getenv("PDO_INFORMIX_MOCK_TYPES");
+	if (types == NULL) {
+		types = "is";
+	}
+	mock_fill_types(&mock_default_shape, types, (int) strlen(types), 0);
+	mock_defaults_loaded = 1;
+}
+
+/* case insensitive search in a counted string */
+static const char *mock_find(const char *text, int len, const char *word)
+{
+	int wlen = (int) strlen(word), i, j;
+
+	for (i = 0; i + wlen <= len; i++) {
+		for (j = 0; j < wlen; j++) {
+			if (tolower((unsigned char) text[i + j]) != tolower((unsigned char) word[j])) {
+				break;
+			}
+		}
+		if (j == wlen) {
+			return text + i;
+		}
+	}
+	return NULL;
+}
+
+/* pick up the mock settings comment from the statement */
+static void mock_parse_shape(mock_stmt *stmt)
+{
+	const char *p, *end, *seg_end = stmt->segment + stmt->segment_len;
+	const char *types = NULL;
+	int types_len = 0, cols = 0;
+
+	mock_load_defaults();
+	stmt->shape = mock_default_shape;
+
+	p = mock_find(stmt->segment, stmt->segment_len, "{mock");
+	if (p == NULL) {
+		return;
+	}
+	end = mock_find(p, (int) (seg_end - p), "}");
+	if (end == NULL) {
+		end = seg_end;
+	}
+	p += 5;
+	while (p < end) {
+		const char *key, *value;
+		int key_len, value_len;
+
+		while (p < end && isspace((unsigned char) *p)) {
+			p++;
+		}
+		key = p;
+		while (p < end && *p != '=' && !isspace((unsigned char) *p)) {
+			p++;
+		}
+		key_len = (int) (p - key);
+		if (p >= end || *p != '=') {
+			continue;
+		}
+		value = ++p;
+		while (p < end && !isspace((unsigned char) *p)) {
+			p++;
+		}
+		value_len = (int) (p - value);
+
+		if (key_len == 4 && strncmp(key, "rows", 4) == 0) {
+			stmt->shape.rows = atol(value);
+			stmt->shape.affected = stmt->shape.rows;
+		} else if (key_len == 4 && strncmp(key, "cols", 4) == 0) {
+			cols = atoi(value);
+		} else if (key_len == 5 && strncmp(key, "types", 5) == 0) {
+			types = value;
+			types_len = value_len;
+		} else if (key_len == 5 && strncmp(key, "width", 5) == 0) {
+			stmt->shape.width = atoi(value);
+		} else if (key_len == 4 && strncmp(key, "fill", 4) == 0) {
+			stmt->shape.fill = atoi(value);
+		} else if (key_len == 3 && strncmp(key, "lob", 3) == 0) {
+			stmt->shape.lob_size = atol(value);
+		}
+	}
+	if (types != NULL || cols > 0) {
+		if (types == NULL) {
+			types = mock_default_shape.types;
+			types_len = (int) strlen(types);
+		}
+		mock_fill_types(&stmt->shape, types, types_len, cols);
+	}
+}
+
+/* the first keyword of a statement, skipping white space and comments */
+static const char *mock_first_word(const char *p, const char *end)
+{
+	for (;;) {
+		while (p < end && isspace((unsigned char) *p)) {
+			p++;
+		}
+		if (end - p >= 2 && p[0] == '/' && p[1] == '*') {
+			const char *close = mock_find(p + 2, (int) (end - p - 2), "*/");
+			p = close != NULL ? close + 2 : end;
+			continue;
+		}
+		if (p < end && *p == '{') {
+			const char *close = mock_find(p + 1, (int) (end - p - 1), "}");
+			p = close != NULL ? close + 1 : end;
+			continue;
+		}
+		if (end - p >= 2 && p[0] == '-' && p[1] == '-') {
+			while (p < end && *p != '\n') {
+				p++;
+			}
+			continue;
+		}
+		return p;
+	}
+}
+
+static int mock_starts_with(const char *p, const char *end, const char *word)
+{
+	int len = (int) strlen(word);
+	return end - p >= len && mock_find(p, len, word) == p;
+}
+
+/* length of the statement starting at p, up to an unquoted ';' */
+static int mock_segment_length(const char *p, const char *end)
+{
+	const char *start = p;
+	char quote = 0;
+
+	for (; p < end; p++) {
+		if (quote) {
+			if (*p == quote) {
+				quote = 0;
+			}
+		} else if (*p == '\'' || *p == '"') {
+			quote = *p;
+		} else if (*p == ';') {
+			break;
+		}
+	}
+	return (int) (p - start);
+}
+
+/* set up the statement at stmt->segment; fails for the simulated errors */
+static SQLRETURN mock_start_segment(mock_stmt *stmt)
+{
+	const char *end = stmt->segment + stmt->segment_len;
+	const char *word = mock_first_word(stmt->segment, end);
+
+	mock_parse_shape(stmt);
+	stmt->is_select = mock_starts_with(word, end, "SELECT") ||
+		mock_starts_with(word, end, "EXECUTE FUNCTION");
+	stmt->is_insert = mock_starts_with(word, end, "INSERT");
+	stmt->cursor = 0;
+	stmt->getdata_col = -1;
+	stmt->getdata_offset = 0;
+
+	if (mock_find(stmt->segment, stmt->segment_len, "no_such_table") != NULL) {
+		mock_set_diag(stmt, "42S02", -206,
+			"[Informix][Mock] The specified table (no_such_table) is not in the database.");
+		return SQL_ERROR;
+	}
+	return SQL_SUCCESS;
+}
+
+static void mock_set_text(mock_stmt *stmt, SQLCHAR *sql, SQLINTEGER len)
+{
+	if (len == SQL_NTS) {
+		len = (SQLINTEGER) strlen((char *) sql);
+	}
+	free(stmt->sql);
+	stmt->sql = malloc(len + 1);
+	memcpy(stmt->sql, sql, len);
+	stmt->sql[len] = '\0';
+	stmt->segment = stmt->sql;
+	stmt->segment_len = mock_segment_length(stmt->sql, stmt->sql + len);
+}
+
+static SQLRETURN mock_lo_call(mock_stmt *stmt);
+
+/* the statement has run: work out what it returns */
+static SQLRETURN mock_finish_execute(mock_stmt *stmt)
+{
+	stmt->executed = 1;
+	stmt->need_data = -1;
+	if (mock_find(stmt->segment, stmt->segment_len, "ifx_lo_") != NULL) {
+		stmt->row_count = 0;
+		return mock_lo_call(stmt);
+	}
+	if (stmt->is_select) {
+		stmt->row_count = 0;
+	} else {
+		stmt->row_count = stmt->shape.affected;
+		if (stmt->is_insert) {
+			stmt->dbc->serial++;
+		}
+	}
+	return SQL_SUCCESS;
+}
+
+/* is the parameter waiting for SQLPutData? */
+static int mock_param_at_exec(mock_bind *param)
+{
+	return param->ind != NULL &&
+		(*param->ind == SQL_DATA_AT_EXEC || *param->ind <= SQL_LEN_DATA_AT_EXEC_OFFSET);
+}
+
+/* ---------------------------------------------------------------------- */
+/* handles, environment and connections */
+
+SQLRETURN SQLAllocHandle(SQLSMALLINT type, SQLHANDLE input, SQLHANDLE *output)
+{
+	void *handle = NULL;
+
+	switch (type) {
+		case SQL_HANDLE_ENV:
+			handle = calloc(1, sizeof(mock_env));
+			if (handle != NULL) {
+				((mock_env *) handle)->kind = MOCK_ENV;
+			}
+			break;
+		case SQL_HANDLE_DBC:
+			handle = calloc(1, sizeof(mock_dbc));
+			if (handle != NULL) {
+				((mock_dbc *) handle)->kind = MOCK_DBC;
+				((mock_dbc *) handle)->autocommit = SQL_AUTOCOMMIT_ON;
+				((mock_dbc *) handle)->isolation = SQL_TXN_READ_COMMITTED;
+			}
+			break;
+		case SQL_HANDLE_STMT:
+			if (input == NULL || !((mock_dbc *) input)->connected) {
+				return SQL_ERROR;
+			}
+			handle = calloc(1, sizeof(mock_stmt));
+			if (handle != NULL) {
+				((mock_stmt *) handle)->kind = MOCK_STMT;
+				((mock_stmt *) handle)->dbc = (mock_dbc *) input;
+				((mock_stmt *) handle)->ird.kind = MOCK_DESC;
+				((mock_stmt *) handle)->ird.stmt = handle;
+				((mock_stmt *) handle)->need_data = -1;
+				((mock_stmt *) handle)->getdata_col = -1;
+				((mock_stmt *) handle)->lo_automatic = ((mock_dbc *) input)->lo_automatic;
+				strcpy(((mock_stmt *) handle)->cursor_name, "SQL_CUR0001");
+			}
+			break;
+		default:
+			return SQL_ERROR;
+	}
+	*output = handle;
+	return handle != NULL ? SQL_SUCCESS : SQL_ERROR;
+}
+
+SQLRETURN SQLFreeHandle(SQLSMALLINT type, SQLHANDLE handle)
+{
+	if (handle == NULL) {
+		return SQL_INVALID_HANDLE;
+	}
+	if (type == SQL_HANDLE_STMT) {
+		free(((mock_stmt *) handle)->sql);
+	}
+	free(handle);
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLSetEnvAttr(SQLHENV henv, SQLINTEGER attr, SQLPOINTER value, SQLINTEGER len)
+{
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLConnect(SQLHDBC hdbc, SQLCHAR *dsn, SQLSMALLINT dsn_len, SQLCHAR *uid,
+	SQLSMALLINT uid_len, SQLCHAR *pwd, SQLSMALLINT pwd_len)
+{
+	((mock_dbc *) hdbc)->connected = 1;
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLDriverConnect(SQLHDBC hdbc, SQLHWND hwnd, SQLCHAR *in, SQLSMALLINT in_len,
+	SQLCHAR *out, SQLSMALLINT out_max, SQLSMALLINT *out_len, SQLUSMALLINT completion)
+{
+	((mock_dbc *) hdbc)->connected = 1;
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLDisconnect(SQLHDBC hdbc)
+{
+	((mock_dbc *) hdbc)->connected = 0;
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLSetConnectAttr(SQLHDBC hdbc, SQLINTEGER attr, SQLPOINTER value, SQLINTEGER len)
+{
+	mock_dbc *dbc = (mock_dbc *) hdbc;
+
+	switch (attr) {
+		case SQL_ATTR_AUTOCOMMIT:
+			dbc->autocommit = (SQLUINTEGER) (SQLULEN) value;
+			break;
+		case SQL_ATTR_TXN_ISOLATION:
+			dbc->isolation = (SQLINTEGER) (SQLLEN) value;
+			break;
+		case SQL_INFX_ATTR_ODBC_TYPES_ONLY:
+			dbc->odbc_types_only = value != NULL;
+			break;
+		case SQL_INFX_ATTR_LO_AUTOMATIC:
+			dbc->lo_automatic = value != NULL;
+			break;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLGetConnectAttr(SQLHDBC hdbc, SQLINTEGER attr, SQLPOINTER value, SQLINTEGER max,
+	SQLINTEGER *len)
+{
+	mock_dbc *dbc = (mock_dbc *) hdbc;
+
+	switch (attr) {
+		case SQL_ATTR_AUTOCOMMIT:
+			*(SQLUINTEGER *) value = dbc->autocommit;
+			break;
+		case SQL_ATTR_TXN_ISOLATION:
+			*(SQLINTEGER *) value = dbc->isolation;
+			break;
+		case SQL_ATTR_CONNECTION_DEAD:
+			*(SQLINTEGER *) value = dbc->connected ? SQL_CD_FALSE : SQL_CD_TRUE;
+			break;
+		default:
+			mock_set_diag(dbc, "HY092", 0, "[Informix][Mock] Invalid attribute");
+			return SQL_ERROR;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLGetInfo(SQLHDBC hdbc, SQLUSMALLINT type, SQLPOINTER value, SQLSMALLINT max,
+	SQLSMALLINT *len)
+{
+	const char *info;
+	SQLSMALLINT info_len;
+
+	switch (type) {
+		case SQL_INFX_LO_PTR_LENGTH:
+			*(SQLUSMALLINT *) value = MOCK_LO_PTR_LENGTH;
+			return SQL_SUCCESS;
+		case SQL_GETDATA_EXTENSIONS:
+			*(SQLUINTEGER *) value = SQL_GD_ANY_COLUMN | SQL_GD_ANY_ORDER | SQL_GD_BOUND;
+			return SQL_SUCCESS;
+		case SQL_DBMS_VER:
+			info = "12.10.0000";
+			break;
+		case SQL_DBMS_NAME:
+			info = "IDS/Mock";
+			break;
+		default:
+			info = "";
+			break;
+	}
+	info_len = (SQLSMALLINT) strlen(info);
+	if (value != NULL && max > 0) {
+		strncpy((char *) value, info, max - 1);
+		((char *) value)[max - 1] = '\0';
+	}
+	if (len != NULL) {
+		*len = info_len;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLEndTran(SQLSMALLINT type, SQLHANDLE handle, SQLSMALLINT completion)
+{
+	return SQL_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------- */
+/* statements */
+
+SQLRETURN SQLPrepare(SQLHSTMT hstmt, SQLCHAR *sql, SQLINTEGER len)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+	const char *p;
+
+	mock_clear_diag(stmt);
+	mock_set_text(stmt, sql, len);
+	stmt->executed = 0;
+	stmt->nparams = 0;
+	for (p = stmt->segment; p < stmt->segment + stmt->segment_len; p++) {
+		if (*p == '?') {
+			stmt->nparams++;
+		}
+	}
+	return mock_start_segment(stmt);
+}
+
+SQLRETURN SQLExecute(SQLHSTMT hstmt)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+	int i;
+
+	mock_clear_diag(stmt);
+	if (stmt->sql == NULL) {
+		mock_set_diag(stmt, "HY010", 0, "[Informix][Mock] Function sequence error");
+		return SQL_ERROR;
+	}
+	stmt->cursor = 0;
+	stmt->getdata_col = -1;
+
+	/* parameters supplied at execute time are asked for through SQLParamData */
+	for (i = 0; i < stmt->nparams && i < MOCK_MAX_PARAMS; i++) {
+		if (mock_param_at_exec(&stmt->params[i])) {
+			stmt->need_data = -1;
+			stmt->executed = 0;
+			return SQL_NEED_DATA;
+		}
+	}
+	return mock_finish_execute(stmt);
+}
+
+SQLRETURN SQLExecDirect(SQLHSTMT hstmt, SQLCHAR *sql, SQLINTEGER len)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+
+	mock_clear_diag(stmt);
+	mock_set_text(stmt, sql, len);
+	stmt->nparams = 0;
+	if (mock_start_segment(stmt) == SQL_ERROR) {
+		return SQL_ERROR;
+	}
+	return mock_finish_execute(stmt);
+}
+
+SQLRETURN SQLParamData(SQLHSTMT hstmt, SQLPOINTER *value)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+	int i;
+
+	for (i = stmt->need_data + 1; i < stmt->nparams && i < MOCK_MAX_PARAMS; i++) {
+		if (mock_param_at_exec(&stmt->params[i])) {
+			stmt->need_data = i;
+			*value = stmt->params[i].value;
+			return SQL_NEED_DATA;
+		}
+	}
+	return mock_finish_execute(stmt);
+}
+
+SQLRETURN SQLPutData(SQLHSTMT hstmt, SQLPOINTER data, SQLLEN len)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+	volatile unsigned char sink = 0;
+	SQLLEN i;
+
+	if (stmt->need_data < 0) {
+		mock_set_diag(stmt, "HY010", 0, "[Informix][Mock] Function sequence error");
+		return SQL_ERROR;
+	}
+	/* look at the data, as a real client copying it into a buffer would */
+	for (i = 0; i < len; i += 64) {
+		sink ^= ((unsigned char *) data)[i];
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLNumResultCols(SQLHSTMT hstmt, SQLSMALLINT *count)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+
+	*count = stmt->is_select ? (SQLSMALLINT) stmt->shape.cols : 0;
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLRowCount(SQLHSTMT hstmt, SQLLEN *count)
+{
+	*count = ((mock_stmt *) hstmt)->row_count;
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLMoreResults(SQLHSTMT hstmt)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+	const char *end = stmt->sql + strlen(stmt->sql);
+	const char *next = stmt->segment + stmt->segment_len;
+
+	/* move past the separator and any empty statements */
+	while (next < end && (*next == ';' || isspace((unsigned char) *next))) {
+		next++;
+	}
+	if (next >= end) {
+		return SQL_NO_DATA;
+	}
+	stmt->segment = next;
+	stmt->segment_len = mock_segment_length(next, end);
+	if (mock_start_segment(stmt) == SQL_ERROR) {
+		return SQL_ERROR;
+	}
+	return mock_finish_execute(stmt);
+}
+
+/* ---------------------------------------------------------------------- */
+/* result description */
+
+/* is the column a CLOB or BLOB handed out as an LO pointer? */
+static int mock_smart_lob(mock_stmt *stmt, char letter)
+{
+	return (letter == 'c' || letter == 'b') && !stmt->lo_automatic;
+}
+
+static SQLSMALLINT mock_col_type(mock_stmt *stmt, char letter)
+{
+	switch (letter) {
+		case 'i':	return SQL_INTEGER;
+		case 'f':	return SQL_DOUBLE;
+		case 'l':	return SQL_BIT;
+		case 'd':	return SQL_TYPE_DATE;
+		case 't':	return SQL_TYPE_TIMESTAMP;
+		case 'c':	return stmt->dbc->odbc_types_only ? SQL_LONGVARCHAR : SQL_INFX_UDT_CLOB;
+		case 'b':	return stmt->dbc->odbc_types_only ? SQL_LONGVARBINARY : SQL_INFX_UDT_BLOB;
+		case 'm':	return stmt->dbc->odbc_types_only ? SQL_VARCHAR : SQL_INFX_RC_MULTISET;
+		case 'r':	return stmt->dbc->odbc_types_only ? SQL_VARCHAR : SQL_INFX_RC_ROW;
+		default:	return SQL_VARCHAR;
+	}
+}
+
+static SQLULEN mock_col_size(mock_stmt *stmt, char letter)
+{
+	switch (letter) {
+		case 'i':	return 11;
+		case 'f':	return 22;
+		case 'l':	return 1;
+		case 'd':	return 10;
+		case 't':	return 25;
+		case 'c':
+		case 'b':	return (SQLULEN) stmt->shape.lob_size;
+		case 'm':
+		case 'r':	return 255;
+		default:	return (SQLULEN) stmt->shape.width;
+	}
+}
+
+static const char *mock_col_type_name(char letter)
+{
+	switch (letter) {
+		case 'i':	return "INTEGER";
+		case 'f':	return "FLOAT";
+		case 'l':	return "BOOLEAN";
+		case 'd':	return "DATE";
+		case 't':	return "DATETIME YEAR TO FRACTION(5)";
+		case 'c':	return "CLOB";
+		case 'b':	return "BLOB";
+		case 'm':	return "MULTISET(VARCHAR(20) NOT NULL)";
+		case 'r':	return "ROW(id INTEGER, name VARCHAR(20), tags LIST(INTEGER NOT NULL))";
+		default:	return "VARCHAR";
+	}
+}
+
+SQLRETURN SQLDescribeCol(SQLHSTMT hstmt, SQLUSMALLINT col, SQLCHAR *name, SQLSMALLINT max,
+	SQLSMALLINT *name_len, SQLSMALLINT *type, SQLULEN *size, SQLSMALLINT *scale,
+	SQLSMALLINT *nullable)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+	char buf[32];
+	char letter;
+
+	if (col < 1 || col > stmt->shape.cols) {
+		mock_set_diag(stmt, "07009", 0, "[Informix][Mock] Invalid descriptor index");
+		return SQL_ERROR;
+	}
+	letter = stmt->shape.types[col - 1];
+	sprintf(buf, "col%d", col);
+	if (name != NULL && max > 0) {
+		strncpy((char *) name, buf, max - 1);
+		name[max - 1] = '\0';
+	}
+	if (name_len != NULL) {
+		*name_len = (SQLSMALLINT) strlen(buf);
+	}
+	if (type != NULL) {
+		*type = mock_col_type(stmt, letter);
+	}
+	if (size != NULL) {
+		*size = mock_col_size(stmt, letter);
+	}
+	if (scale != NULL) {
+		*scale = letter == 't' ? 5 : 0;
+	}
+	if (nullable != NULL) {
+		*nullable = 1;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLColAttribute(SQLHSTMT hstmt, SQLUSMALLINT col, SQLUSMALLINT field,
+	SQLPOINTER char_value, SQLSMALLINT max, SQLSMALLINT *len, SQLPOINTER num_value)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+	const char *text = NULL;
+	char letter;
+
+	if (col < 1 || col > stmt->shape.cols) {
+		mock_set_diag(stmt, "07009", 0, "[Informix][Mock] Invalid descriptor index");
+		return SQL_ERROR;
+	}
+	letter = stmt->shape.types[col - 1];
+	switch (field) {
+		case SQL_DESC_DISPLAY_SIZE:
+			*(SQLLEN *) num_value = (SQLLEN) mock_col_size(stmt, letter);
+			return SQL_SUCCESS;
+		case SQL_DESC_UNSIGNED:
+		case SQL_DESC_AUTO_UNIQUE_VALUE:
+			*(SQLINTEGER *) num_value = SQL_FALSE;
+			return SQL_SUCCESS;
+		case SQL_DESC_TYPE_NAME:
+			text = mock_col_type_name(letter);
+			break;
+		case SQL_DESC_BASE_TABLE_NAME:
+			text = "mock";
+			break;
+		default:
+			mock_set_diag(stmt, "HY091", 0, "[Informix][Mock] Invalid descriptor field");
+			return SQL_ERROR;
+	}
+	if (char_value != NULL && max > 0) {
+		strncpy((char *) char_value, text, max - 1);
+		((char *) char_value)[max - 1] = '\0';
+	}
+	if (len != NULL) {
+		*len = (SQLSMALLINT) strlen(text);
+	}
+	return SQL_SUCCESS;
+}
+
+/* the descriptor's view of the same columns: verbose types, octet lengths */
+SQLRETURN SQLGetDescRec(SQLHDESC hdesc, SQLSMALLINT rec, SQLCHAR *name, SQLSMALLINT max,
+	SQLSMALLINT *name_len, SQLSMALLINT *type, SQLSMALLINT *subtype, SQLLEN *length,
+	SQLSMALLINT *precision, SQLSMALLINT *scale, SQLSMALLINT *nullable)
+{
+	mock_desc *desc = (mock_desc *) hdesc;
+	mock_stmt *stmt = (mock_stmt *) desc->stmt;
+	SQLSMALLINT concise;
+	SQLULEN size;
+	SQLRETURN rc;
+
+	if (desc->kind != MOCK_DESC) {
+		return SQL_INVALID_HANDLE;
+	}
+	if (rec < 1 || rec > stmt->shape.cols) {
+		mock_set_diag(desc, "07009", 0, "[Informix][Mock] Invalid descriptor index");
+		return SQL_ERROR;
+	}
+	rc = SQLDescribeCol(stmt, rec, name, max, name_len, &concise, &size, scale, nullable);
+	if (concise == SQL_TYPE_DATE || concise == SQL_TYPE_TIMESTAMP) {
+		*type = SQL_DATETIME;
+		*subtype = concise == SQL_TYPE_DATE ? SQL_CODE_DATE : SQL_CODE_TIMESTAMP;
+	} else {
+		*type = concise;
+		*subtype = 0;
+	}
+	*length = (SQLLEN) size;
+	*precision = 0;
+	return rc;
+}
+
+SQLRETURN SQLDescribeParam(SQLHSTMT hstmt, SQLUSMALLINT param, SQLSMALLINT *type,
+	SQLULEN *size, SQLSMALLINT *scale, SQLSMALLINT *nullable)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+
+	if (param < 1 || param > stmt->nparams) {
+		mock_set_diag(stmt, "07009", 0, "[Informix][Mock] Invalid descriptor index");
+		return SQL_ERROR;
+	}
+	*type = SQL_VARCHAR;
+	*size = 255;
+	*scale = 0;
+	*nullable = 1;
+	return SQL_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------- */
+/* binding and data transfer */
+
+SQLRETURN SQLBindParameter(SQLHSTMT hstmt, SQLUSMALLINT param, SQLSMALLINT io_type,
+	SQLSMALLINT c_type, SQLSMALLINT sql_type, SQLULEN size, SQLSMALLINT scale,
+	SQLPOINTER value, SQLLEN max, SQLLEN *ind)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+
+	if (param < 1 || param > MOCK_MAX_PARAMS) {
+		mock_set_diag(stmt, "07009", 0, "[Informix][Mock] Invalid parameter number");
+		return SQL_ERROR;
+	}
+	stmt->params[param - 1].ctype = c_type;
+	stmt->params[param - 1].value = value;
+	stmt->params[param - 1].max = max;
+	stmt->params[param - 1].ind = ind;
+	if (param > stmt->nparams) {
+		stmt->nparams = param;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLBindCol(SQLHSTMT hstmt, SQLUSMALLINT col, SQLSMALLINT c_type, SQLPOINTER value,
+	SQLLEN max, SQLLEN *ind)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+
+	if (col < 1 || col > MOCK_MAX_COLS) {
+		mock_set_diag(stmt, "07009", 0, "[Informix][Mock] Invalid descriptor index");
+		return SQL_ERROR;
+	}
+	stmt->cols[col - 1].ctype = c_type;
+	stmt->cols[col - 1].value = value;
+	stmt->cols[col - 1].max = max;
+	stmt->cols[col - 1].ind = ind;
+	return SQL_SUCCESS;
+}
+
+/* length of the value of a column in the current row */
+static long mock_value_length(mock_stmt *stmt, int col)
+{
+	switch (stmt->shape.types[col]) {
+		case 'c':
+		case 'b':
+			return stmt->shape.lob_size;
+		case 't':
+			return 25;
+		case 's':
+			if (stmt->shape.fill > 0 && stmt->shape.fill < stmt->shape.width) {
+				return stmt->shape.fill;
+			}
+			return stmt->shape.width;
+		default:
+			return -1;
+	}
+}
+
+/* the character form of a short column value */
+static int mock_format_value(mock_stmt *stmt, int col, char *buf, int size)
+{
+	long row = stmt->cursor;
+
+	switch (stmt->shape.types[col]) {
+		case 'i':
+			return snprintf(buf, size, "%ld", row * stmt->shape.cols + col);
+		case 'f':
+			return snprintf(buf, size, "%ld.%03ld", row, (long) col);
+		case 'l':
+			return snprintf(buf, size, "%c", row % 2 ? 't' : 'f');
+		case 'd':
+			return snprintf(buf, size, "2026-01-%02ld", row % 28 + 1);
+		case 't':
+			return snprintf(buf, size, "2026-01-%02ld 12:34:56.12345", row % 28 + 1);
+		case 'm':
+			return snprintf(buf, size, "MULTISET{'row %ld','it''s',NULL}", row);
+		case 'r':
+			return snprintf(buf, size, "ROW(%ld,'name',LIST{1,2})", row);
+		default:
+			return -1;
+	}
+}
+
+/* byte of a long (character, CLOB or BLOB) value */
+#define MOCK_BYTE(row, col, offset) ((char) ('A' + ((row) + (col) + (offset)) % 26))
+
+/*
+* Copy the part of a column value starting at offset into a client buffer,
+* the way SQLGetData and bound columns do.  Returns the bytes copied.
+*/
+static SQLLEN mock_copy_value(mock_stmt *stmt, int col, SQLSMALLINT ctype, SQLPOINTER target,
+	SQLLEN max, SQLLEN *ind, long offset)
+{
+	char buf[64];
+	long len = mock_value_length(stmt, col), remaining, copy, i;
+	int text = (ctype == SQL_C_CHAR);
+
+	if (ctype == SQL_C_LONG && stmt->shape.types[col] == 'i') {
+		*(SQLINTEGER *) target = (SQLINTEGER) (stmt->cursor * stmt->shape.cols + col);
+		if (ind != NULL) {
+			*ind = sizeof(SQLINTEGER);
+		}
+		return sizeof(SQLINTEGER);
+	}
+
+	if (ctype == SQL_C_BINARY && mock_smart_lob(stmt, stmt->shape.types[col])) {
+		mock_locator loc;
+
+		memset(&loc, 0, sizeof(loc));
+		memcpy(loc.magic, "MOCKLO", 7);
+		loc.row = stmt->cursor;
+		loc.col = col;
+		loc.size = stmt->shape.lob_size;
+		if (target != NULL && max >= MOCK_LO_PTR_LENGTH) {
+			memset(target, 0, MOCK_LO_PTR_LENGTH);
+			memcpy(target, &loc, sizeof(loc));
+		}
+		if (ind != NULL) {
+			*ind = MOCK_LO_PTR_LENGTH;
+		}
+		return MOCK_LO_PTR_LENGTH;
+	}
+
+	if (ctype == SQL_C_BIT) {
+		*(unsigned char *) target = (unsigned char) (stmt->cursor % 2);
+		if (ind != NULL) {
+			*ind = 1;
+		}
+		return 1;
+	}
+
+	if (ctype == SQL_C_TYPE_DATE || ctype == SQL_C_TYPE_TIMESTAMP) {
+		char letter = stmt->shape.types[col];
+		TIMESTAMP_STRUCT ts;
+
+		memset(&ts, 0, sizeof(ts));
+		ts.year = 2026;
+		ts.month = 1;
+		ts.day = (SQLUSMALLINT) (stmt->cursor % 28 + 1);
+		if (letter == 't' && ctype == SQL_C_TYPE_TIMESTAMP) {
+			ts.hour = 12;
+			ts.minute = 34;
+			ts.second = 56;
+			ts.fraction = 123450000;
+		}
+		if (ctype == SQL_C_TYPE_DATE) {
+			memcpy(target, &ts, sizeof(DATE_STRUCT));
+		} else {
+			memcpy(target, &ts, sizeof(TIMESTAMP_STRUCT));
+		}
+		if (ind != NULL) {
+			*ind = ctype == SQL_C_TYPE_DATE ? sizeof(DATE_STRUCT) : sizeof(TIMESTAMP_STRUCT);
+		}
+		return ctype == SQL_C_TYPE_DATE ? sizeof(DATE_STRUCT) : sizeof(TIMESTAMP_STRUCT);
+	}
+
+	if (len < 0) {
+		len = mock_format_value(stmt, col, buf, sizeof(buf));
+	} else if (stmt->shape.types[col] == 't') {
+		mock_format_value(stmt, col, buf, sizeof(buf));
+	}
+	remaining = len - offset;
+	if (ind != NULL) {
+		*ind = remaining;
+	}
+	copy = remaining;
+	if (text && copy > max - 1) {
+		copy = max > 0 ? max - 1 : 0;
+	} else if (!text && copy > max) {
+		copy = max;
+	}
+	if (target == NULL) {
+		return 0;
+	}
+	switch (stmt->shape.types[col]) {
+		case 'i':
+		case 'f':
+		case 'l':
+		case 'd':
+		case 't':
+		case 'm':
+		case 'r':
+			memcpy(target, buf + offset, copy);
+			break;
+		default:
+			for (i = 0; i < copy; i++) {
+				((char *) target)[i] = MOCK_BYTE(stmt->cursor, col, offset + i);
+			}
+			break;
+	}
+	if (text && max > 0) {
+		((char *) target)[copy] = '\0';
+	}
+	return copy;
+}
+
+SQLRETURN SQLFetchScroll(SQLHSTMT hstmt, SQLSMALLINT orientation, SQLLEN offset)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+	long rows = stmt->shape.rows, target;
+	int col;
+
+	if (!stmt->executed || !stmt->is_select) {
+		mock_set_diag(stmt, "24000", 0, "[Informix][Mock] Invalid cursor state");
+		return SQL_ERROR;
+	}
+	switch (orientation) {
+		case SQL_FETCH_FIRST:		target = 1; break;
+		case SQL_FETCH_LAST:		target = rows; break;
+		case SQL_FETCH_PRIOR:		target = stmt->cursor - 1; break;
+		case SQL_FETCH_ABSOLUTE:	target = offset < 0 ? rows + 1 + offset : offset; break;
+		case SQL_FETCH_RELATIVE:	target = stmt->cursor + offset; break;
+		default:					target = stmt->cursor + 1; break;
+	}
+	if (orientation != SQL_FETCH_NEXT && stmt->cursor_type == SQL_CURSOR_FORWARD_ONLY) {
+		mock_set_diag(stmt, "HY106", 0, "[Informix][Mock] Fetch type out of range");
+		return SQL_ERROR;
+	}
+	if (target < 1) {
+		stmt->cursor = 0;
+		return SQL_NO_DATA;
+	}
+	if (target > rows) {
+		stmt->cursor = rows + 1;
+		return SQL_NO_DATA;
+	}
+	stmt->cursor = target;
+	stmt->getdata_col = -1;
+
+	/* fill in the bound columns */
+	for (col = 0; col < stmt->shape.cols; col++) {
+		mock_bind *bind = &stmt->cols[col];
+		if (bind->value != NULL) {
+			mock_copy_value(stmt, col, bind->ctype, bind->value, bind->max, bind->ind, 0);
+		}
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLGetData(SQLHSTMT hstmt, SQLUSMALLINT col, SQLSMALLINT c_type, SQLPOINTER value,
+	SQLLEN max, SQLLEN *ind)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+	long len;
+	SQLLEN copied;
+
+	if (stmt->cursor < 1 || stmt->cursor > stmt->shape.rows || col < 1 || col > stmt->shape.cols) {
+		mock_set_diag(stmt, "24000", 0, "[Informix][Mock] Invalid cursor state");
+		return SQL_ERROR;
+	}
+	/* reading another column starts from its beginning */
+	if (stmt->getdata_col != col - 1) {
+		stmt->getdata_col = col - 1;
+		stmt->getdata_offset = 0;
+	}
+	len = mock_value_length(stmt, col - 1);
+	if (len < 0) {
+		char buf[64];
+		len = mock_format_value(stmt, col - 1, buf, sizeof(buf));
+	}
+	if (stmt->getdata_offset > 0 && stmt->getdata_offset >= len) {
+		return SQL_NO_DATA;
+	}
+	copied = mock_copy_value(stmt, col - 1, c_type, value, max, ind, stmt->getdata_offset);
+	/* fixed size conversions and LO pointers are read whole */
+	if ((c_type != SQL_C_CHAR && c_type != SQL_C_BINARY) ||
+			(c_type == SQL_C_BINARY && mock_smart_lob(stmt, stmt->shape.types[col - 1]))) {
+		stmt->getdata_offset = len;
+		return SQL_SUCCESS;
+	}
+	if (value == NULL || max == 0) {
+		return SQL_SUCCESS_WITH_INFO;
+	}
+	stmt->getdata_offset += copied;
+	if (stmt->getdata_offset < len) {
+		mock_set_diag(stmt, "01004", 0, "[Informix][Mock] String data, right truncated");
+		return SQL_SUCCESS_WITH_INFO;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLFreeStmt(SQLHSTMT hstmt, SQLUSMALLINT option)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+
+	switch (option) {
+		case SQL_CLOSE:
+			stmt->cursor = 0;
+			stmt->executed = 0;
+			break;
+		case SQL_UNBIND:
+			memset(stmt->cols, 0, sizeof(stmt->cols));
+			break;
+		case SQL_RESET_PARAMS:
+			memset(stmt->params, 0, sizeof(stmt->params));
+			break;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLCloseCursor(SQLHSTMT hstmt)
+{
+	return SQLFreeStmt(hstmt, SQL_CLOSE);
+}
+
+SQLRETURN SQLCancel(SQLHSTMT hstmt)
+{
+	((mock_stmt *) hstmt)->need_data = -1;
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLSetStmtAttr(SQLHSTMT hstmt, SQLINTEGER attr, SQLPOINTER value, SQLINTEGER len)
+{
+	if (attr == SQL_ATTR_CURSOR_TYPE) {
+		((mock_stmt *) hstmt)->cursor_type = (SQLULEN) value;
+	} else if (attr == SQL_INFX_ATTR_LO_AUTOMATIC) {
+		((mock_stmt *) hstmt)->lo_automatic = value != NULL;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLGetStmtAttr(SQLHSTMT hstmt, SQLINTEGER attr, SQLPOINTER value, SQLINTEGER max,
+	SQLINTEGER *len)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+
+	switch (attr) {
+		case SQL_GET_SERIAL_VALUE:
+			*(SQLINTEGER *) value = stmt->dbc->serial;
+			return SQL_SUCCESS;
+		case SQL_ATTR_CURSOR_TYPE:
+			*(SQLULEN *) value = stmt->cursor_type;
+			return SQL_SUCCESS;
+		case SQL_ATTR_IMP_ROW_DESC:
+			*(SQLHDESC *) value = &stmt->ird;
+			return SQL_SUCCESS;
+	}
+	mock_set_diag(stmt, "HY092", 0, "[Informix][Mock] Invalid attribute");
+	return SQL_ERROR;
+}
+
+SQLRETURN SQLSetCursorName(SQLHSTMT hstmt, SQLCHAR *name, SQLSMALLINT len)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+
+	if (len == SQL_NTS) {
+		len = (SQLSMALLINT) strlen((char *) name);
+	}
+	if (len >= (SQLSMALLINT) sizeof(stmt->cursor_name)) {
+		len = sizeof(stmt->cursor_name) - 1;
+	}
+	memcpy(stmt->cursor_name, name, len);
+	stmt->cursor_name[len] = '\0';
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLGetCursorName(SQLHSTMT hstmt, SQLCHAR *name, SQLSMALLINT max, SQLSMALLINT *len)
+{
+	mock_stmt *stmt = (mock_stmt *) hstmt;
+
+	if (max > 0) {
+		strncpy((char *) name, stmt->cursor_name, max - 1);
+		name[max - 1] = '\0';
+	}
+	*len = (SQLSMALLINT) strlen(stmt->cursor_name);
+	return SQL_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------- */
+/* smart large objects */
+
+int ifx_int8cvdbl(double value, ifx_int8_t *int8)
+{
+	double magnitude = value < 0 ? -value : value;
+
+	int8->sign = value < 0 ? -1 : 1;
+	int8->data[1] = (unsigned int) (magnitude / 4294967296.0);
+	int8->data[0] = (unsigned int) (magnitude - int8->data[1] * 4294967296.0);
+	return 0;
+}
+
+int ifx_int8todbl(ifx_int8_t *int8, double *value)
+{
+	*value = (int8->data[1] * 4294967296.0 + int8->data[0]) * (int8->sign < 0 ? -1 : 1);
+	return 0;
+}
+
+static mock_lo *mock_lo_get(mock_stmt *stmt, SQLPOINTER fd_param)
+{
+	SQLINTEGER fd = fd_param != NULL ? *(SQLINTEGER *) fd_param : -1;
+
+	if (fd < 0 || fd >= MOCK_MAX_LOS || !stmt->dbc->los[fd].open) {
+		mock_set_diag(stmt, "HY000", -9810, "[Informix][Mock] Invalid smart large object descriptor");
+		return NULL;
+	}
+	return &stmt->dbc->los[fd];
+}
+
+/*
+* The ifx_lo_* escapes, with the parameters bound the way the driver binds
+* them.  Reads and writes take only the documented form, and report the
+* byte count through the length indicator of the buffer:
+*
+*   {? = call ifx_lo_open(loptr, mode)}
+*   {call ifx_lo_read(lofd, buffer)}
+*   {call ifx_lo_write(lofd, buffer)}
+*   {call ifx_lo_seek(lofd, offset, whence, position)}
+*   {call ifx_lo_close(lofd)}
+*/
+static SQLRETURN mock_lo_call(mock_stmt *stmt)
+{
+	mock_bind *p = stmt->params;
+	mock_lo *lo;
+	long i, n;
+
+	if (mock_find(stmt->segment, stmt->segment_len, "ifx_lo_open") != NULL) {
+		mock_locator loc;
+		SQLINTEGER fd;
+
+		memcpy(&loc, p[1].value, sizeof(loc));
+		if (memcmp(loc.magic, "MOCKLO", 7) != 0) {
+			mock_set_diag(stmt, "HY000", -9810, "[Informix][Mock] Invalid LO pointer");
+			return SQL_ERROR;
+		}
+		for (fd = 0; fd < MOCK_MAX_LOS && stmt->dbc->los[fd].open; fd++) {
+		}
+		if (fd == MOCK_MAX_LOS) {
+			mock_set_diag(stmt, "HY000", -9810, "[Informix][Mock] Too many open smart large objects");
+			return SQL_ERROR;
+		}
+		lo = &stmt->dbc->los[fd];
+		memset(lo, 0, sizeof(*lo));
+		lo->open = 1;
+		lo->loc = loc;
+		lo->writable = (*(SQLINTEGER *) p[2].value & LO_RDWR) != 0;
+		*(SQLINTEGER *) p[0].value = fd;
+		return SQL_SUCCESS;
+	}
+
+	if (mock_find(stmt->segment, stmt->segment_len, "{call ifx_lo_read(?, ?)}") != NULL) {
+		if ((lo = mock_lo_get(stmt, p[0].value)) == NULL) {
+			return SQL_ERROR;
+		}
+		n = lo->loc.size - lo->pos;
+		if (n > p[1].max) {
+			n = p[1].max;
+		}
+		if (n < 0) {
+			n = 0;
+		}
+		for (i = 0; i < n; i++) {
+			((char *) p[1].value)[i] = lo->data != NULL ? lo->data[lo->pos + i] :
+				MOCK_BYTE(lo->loc.row, lo->loc.col, lo->pos + i);
+		}
+		lo->pos += n;
+		if (p[1].ind != NULL) {
+			*p[1].ind = n;
+		}
+		return SQL_SUCCESS;
+	}
+
+	if (mock_find(stmt->segment, stmt->segment_len, "{call ifx_lo_write(?, ?)}") != NULL) {
+		if ((lo = mock_lo_get(stmt, p[0].value)) == NULL) {
+			return SQL_ERROR;
+		}
+		if (!lo->writable) {
+			mock_set_diag(stmt, "HY000", -9810,
+				"[Informix][Mock] Smart large object is not open for writing");
+			return SQL_ERROR;
+		}
+		n = p[1].ind != NULL ? (long) *p[1].ind : p[1].max;
+		if (lo->data == NULL || lo->pos + n > lo->loc.size) {
+			long size = lo->pos + n > lo->loc.size ? lo->pos + n : lo->loc.size;
+			char *data = malloc(size);
+
+			for (i = 0; i < size; i++) {
+				data[i] = lo->data != NULL && i < lo->loc.size ? lo->data[i] :
+					MOCK_BYTE(lo->loc.row, lo->loc.col, i);
+			}
+			free(lo->data);
+			lo->data = data;
+			lo->loc.size = size;
+		}
+		memcpy(lo->data + lo->pos, p[1].value, n);
+		lo->pos += n;
+		return SQL_SUCCESS;
+	}
+
+	if (mock_find(stmt->segment, stmt->segment_len, "ifx_lo_seek") != NULL) {
+		double offset, base;
+
+		if ((lo = mock_lo_get(stmt, p[0].value)) == NULL) {
+			return SQL_ERROR;
+		}
+		ifx_int8todbl((ifx_int8_t *) p[1].value, &offset);
+		switch (*(SQLINTEGER *) p[2].value) {
+			case LO_SEEK_CUR:	base = (double) lo->pos; break;
+			case LO_SEEK_END:	base = (double) lo->loc.size; break;
+			default:			base = 0; break;
+		}
+		if (base + offset < 0) {
+			mock_set_diag(stmt, "HY000", -9810, "[Informix][Mock] Invalid seek position");
+			return SQL_ERROR;
+		}
+		lo->pos = (long) (base + offset);
+		ifx_int8cvdbl((double) lo->pos, (ifx_int8_t *) p[3].value);
+		return SQL_SUCCESS;
+	}
+
+	if (mock_find(stmt->segment, stmt->segment_len, "ifx_lo_close") != NULL) {
+		if ((lo = mock_lo_get(stmt, p[0].value)) == NULL) {
+			return SQL_ERROR;
+		}
+		free(lo->data);
+		memset(lo, 0, sizeof(*lo));
+		return SQL_SUCCESS;
+	}
+
+	mock_set_diag(stmt, "42000", -674, "[Informix][Mock] Routine cannot be resolved");
+	return SQL_ERROR;
+}
+
+/* ---------------------------------------------------------------------- */
+/* diagnostics */
+
+SQLRETURN SQLGetDiagRec(SQLSMALLINT type, SQLHANDLE handle, SQLSMALLINT rec, SQLCHAR *state,
+	SQLINTEGER *native, SQLCHAR *msg, SQLSMALLINT max, SQLSMALLINT *len)
+{
+	mock_diag *diag;
+	SQLSMALLINT msg_len;
+
+	if (handle == NULL) {
+		return SQL_INVALID_HANDLE;
+	}
+	diag = &((mock_handle *) handle)->diag;
+	if (rec != 1 || !diag->set) {
+		return SQL_NO_DATA;
+	}
+	if (state != NULL) {
+		memcpy(state, diag->state, SQL_SQLSTATE_SIZE + 1);
+	}
+	if (native != NULL) {
+		*native = diag->native;
+	}
+	msg_len = (SQLSMALLINT) strlen(diag->msg);
+	if (msg_len >= max) {
+		msg_len = max > 0 ? max - 1 : 0;
+	}
+	if (msg != NULL && max > 0) {
+		memcpy(msg, diag->msg, msg_len);
+		msg[msg_len] = '\0';
+	}
+	if (len != NULL) {
+		*len = msg_len;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQLGetDiagField(SQLSMALLINT type, SQLHANDLE handle, SQLSMALLINT rec,
+	SQLSMALLINT field, SQLPOINTER value, SQLSMALLINT max, SQLSMALLINT *len)
+{
+	if (type == SQL_HANDLE_STMT && field == SQL_DIAG_DYNAMIC_FUNCTION_CODE) {
+		mock_stmt *stmt = (mock_stmt *) handle;
+		*(SQLINTEGER *) value = stmt->is_insert ? SQL_DIAG_INSERT :
+			(stmt->is_select ? SQL_DIAG_SELECT_CURSOR : 0);
+		return SQL_SUCCESS;
+	}
+	return SQL_NO_DATA;
+}
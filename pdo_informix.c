@@ -26,25 +26,47 @@
 #include "php.h"
 #include "php_ini.h"
 #include "ext/standard/info.h"
+#include "pdo/php_pdo.h"
 #include "pdo/php_pdo_driver.h"
 #include "php_pdo_informix.h"
 #include "php_pdo_informix_int.h"
 
-/* If you declare any globals in php_pdo_informix.h uncomment this:
 ZEND_DECLARE_MODULE_GLOBALS(pdo_informix)
-*/
 
 /* True global resources - no need for thread safety here */
 static int le_pdo_informix;
 extern pdo_driver_t pdo_informix_driver;	/* the registration table */
 
+/*
+* The CLI environment shared by every connection in the process.  It is
+* created at module startup and reference counted, so that it stays alive
+* for as long as any connection (persistent ones included) still hangs
+* a connection handle off it.
+*/
+static SQLHANDLE informix_henv = SQL_NULL_HANDLE;
+static int informix_henv_refcount = 0;
+#ifdef ZTS
+static MUTEX_T informix_henv_mutex = NULL;
+#define INFORMIX_ENV_LOCK()		tsrm_mutex_lock(informix_henv_mutex)
+#define INFORMIX_ENV_UNLOCK()	tsrm_mutex_unlock(informix_henv_mutex)
+#define INFORMIX_ENV_LOCK_FREE()	\
+	do { \
+		tsrm_mutex_free(informix_henv_mutex); \
+		informix_henv_mutex = NULL; \
+	} while (0)
+#else
+#define INFORMIX_ENV_LOCK()
+#define INFORMIX_ENV_UNLOCK()
+#define INFORMIX_ENV_LOCK_FREE()
+#endif
+
 /* {{{ pdo_informix_functions[]
  *
  * Every user visible function must have an entry in pdo_informix_functions[].
  */
 zend_function_entry pdo_informix_functions[] =
 {
-	PHP_FE(confirm_pdo_informix_compiled, NULL)	/* For testing, remove later. */
+	PHP_FE(pdo_informix_get_stats, NULL)
 	{
 		NULL, NULL, NULL
 	}	/* Must be the last line in pdo_informix_functions[] */
@@ -75,10 +97,10 @@ zend_module_entry pdo_informix_module_entry =
 	pdo_informix_functions,
 	PHP_MINIT(pdo_informix),
 	PHP_MSHUTDOWN(pdo_informix),
-	PHP_RINIT(pdo_informix),        /* Replace with NULL if there's nothing to do at request start */
-	PHP_RSHUTDOWN(pdo_informix),    /* Replace with NULL if there's nothing to do at request end */
+	PHP_RINIT(pdo_informix),
+	PHP_RSHUTDOWN(pdo_informix),
 	PHP_MINFO(pdo_informix),
-	PDO_INFORMIX_VERSION,   /* Replace with version number for your extension */
+	PDO_INFORMIX_VERSION,
 	STANDARD_MODULE_PROPERTIES
 };
 /* }}} */
@@ -87,37 +109,139 @@ zend_module_entry pdo_informix_module_entry =
 ZEND_GET_MODULE(pdo_informix)
 #endif
 
+/* {{{ PHP_INI_MH
+ * The LOB chunk size is an allocation size, so refuse anything that is not positive.
+ */
+static PHP_INI_MH(OnUpdateLobChunkSize)
+{
+	if (atol(new_value) <= 0) {
+		return FAILURE;
+	}
+	return OnUpdateLong(entry, new_value, new_value_length, mh_arg1, mh_arg2, mh_arg3, stage TSRMLS_CC);
+}
+/* }}} */
+
 /* {{{ PHP_INI
  */
-/* Remove comments and fill if you need to have entries in php.ini
 PHP_INI_BEGIN()
-	STD_PHP_INI_ENTRY("pdo_informix.global_value",      "42", PHP_INI_ALL, OnUpdateLong, global_value, zend_pdo_informix_globals, pdo_informix_globals)
-	STD_PHP_INI_ENTRY("pdo_informix.global_string", "foobar", PHP_INI_ALL, OnUpdateString, global_string, zend_pdo_informix_globals, pdo_informix_globals)
+	STD_PHP_INI_ENTRY("pdo_informix.slow_query_threshold_ms", "-1", PHP_INI_ALL, OnUpdateLong, slow_query_threshold, zend_pdo_informix_globals, pdo_informix_globals)
+	STD_PHP_INI_ENTRY("pdo_informix.slow_query_log", "", PHP_INI_SYSTEM, OnUpdateString, slow_query_log, zend_pdo_informix_globals, pdo_informix_globals)
+	STD_PHP_INI_BOOLEAN("pdo_informix.slow_query_redact", "1", PHP_INI_SYSTEM, OnUpdateBool, slow_query_redact, zend_pdo_informix_globals, pdo_informix_globals)
+	STD_PHP_INI_ENTRY("pdo_informix.lob_chunk_size", "8192", PHP_INI_ALL, OnUpdateLobChunkSize, lob_chunk_size, zend_pdo_informix_globals, pdo_informix_globals)
+	STD_PHP_INI_ENTRY("pdo_informix.liveness_check_interval", "60", PHP_INI_ALL, OnUpdateLong, liveness_check_interval, zend_pdo_informix_globals, pdo_informix_globals)
+	STD_PHP_INI_ENTRY("pdo_informix.query_timeout", "0", PHP_INI_ALL, OnUpdateLong, query_timeout, zend_pdo_informix_globals, pdo_informix_globals)
+	STD_PHP_INI_ENTRY("pdo_informix.max_bind_size", "8192", PHP_INI_ALL, OnUpdateLong, max_bind_size, zend_pdo_informix_globals, pdo_informix_globals)
 PHP_INI_END()
-*/
 /* }}} */
 
 /* {{{ php_pdo_informix_init_globals
  */
-/* Uncomment this function if you have INI entries
 static void php_pdo_informix_init_globals(zend_pdo_informix_globals *pdo_informix_globals)
 {
-	pdo_informix_globals->global_value = 0;
-	pdo_informix_globals->global_string = NULL;
+	memset(pdo_informix_globals, 0, sizeof(*pdo_informix_globals));
+	pdo_informix_globals->dirty_conns = NULL;
+}
+/* }}} */
+
+/* {{{ informix_env_acquire
+ * Take a reference on the shared environment.  Returns SQL_NULL_HANDLE if
+ * the environment could not be created at startup.
+ */
+SQLHANDLE informix_env_acquire(void)
+{
+	SQLHANDLE henv;
+
+	INFORMIX_ENV_LOCK();
+	henv = informix_henv;
+	if (henv != SQL_NULL_HANDLE) {
+		informix_henv_refcount++;
+	}
+	INFORMIX_ENV_UNLOCK();
+	return henv;
+}
+/* }}} */
+
+/* {{{ informix_env_release
+ * Drop a reference on the shared environment, freeing it with the last one.
+ * The module's own reference is only dropped at module shutdown, so once
+ * the last one is gone nothing can take the lock again, and it goes too.
+ */
+void informix_env_release(void)
+{
+	INFORMIX_ENV_LOCK();
+	if (informix_henv_refcount > 0 && --informix_henv_refcount == 0) {
+		SQLFreeHandle(SQL_HANDLE_ENV, informix_henv);
+		informix_henv = SQL_NULL_HANDLE;
+		INFORMIX_ENV_UNLOCK();
+		INFORMIX_ENV_LOCK_FREE();
+		return;
+	}
+	INFORMIX_ENV_UNLOCK();
+}
+/* }}} */
+
+/* {{{ informix_env_init
+ * Allocate the shared environment.  The module itself holds the first
+ * reference, which is dropped again at module shutdown.
+ */
+static void informix_env_init(void)
+{
+	int rc = SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &informix_henv);
+	if (rc == SQL_ERROR) {
+		informix_henv = SQL_NULL_HANDLE;
+		return;
+	}
+	/* and we're using the OBDC version 3 style interface */
+	rc = SQLSetEnvAttr((SQLHENV) informix_henv, SQL_ATTR_ODBC_VERSION,
+			(void *) SQL_OV_ODBC3, 0);
+	if (rc == SQL_ERROR) {
+		SQLFreeHandle(SQL_HANDLE_ENV, informix_henv);
+		informix_henv = SQL_NULL_HANDLE;
+		return;
+	}
+	informix_henv_refcount = 1;
 }
-*/
 /* }}} */
 
 /* {{{ PHP_MINIT_FUNCTION
  */
 PHP_MINIT_FUNCTION(pdo_informix)
 {
-	/* If you have INI entries, uncomment these lines
 	ZEND_INIT_MODULE_GLOBALS(pdo_informix, php_pdo_informix_init_globals, NULL);
 	REGISTER_INI_ENTRIES();
-	*/
 
-	
+#ifdef ZTS
+	informix_henv_mutex = tsrm_mutex_alloc();
+#endif
+	informix_env_init();
+
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_LIVENESS_INTERVAL", (long) PDO_INFORMIX_ATTR_LIVENESS_INTERVAL);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_RESET_ON_REUSE", (long) PDO_INFORMIX_ATTR_RESET_ON_REUSE);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_ISOLATION", (long) PDO_INFORMIX_ATTR_ISOLATION);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_LOCK_WAIT", (long) PDO_INFORMIX_ATTR_LOCK_WAIT);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_PDQPRIORITY", (long) PDO_INFORMIX_ATTR_PDQPRIORITY);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_OPTCOMPIND", (long) PDO_INFORMIX_ATTR_OPTCOMPIND);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_BEGIN_WORK", (long) PDO_INFORMIX_ATTR_BEGIN_WORK);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_STATS", (long) PDO_INFORMIX_ATTR_STATS);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_LOB_CHUNK_SIZE", (long) PDO_INFORMIX_ATTR_LOB_CHUNK_SIZE);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_QUERY_TIMEOUT", (long) PDO_INFORMIX_ATTR_QUERY_TIMEOUT);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_TEMPORAL_MODE", (long) PDO_INFORMIX_ATTR_TEMPORAL_MODE);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_SMART_LOB", (long) PDO_INFORMIX_ATTR_SMART_LOB);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_LOB_WRITABLE", (long) PDO_INFORMIX_ATTR_LOB_WRITABLE);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_COMPLEX_TYPES", (long) PDO_INFORMIX_ATTR_COMPLEX_TYPES);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_MAX_BIND_SIZE", (long) PDO_INFORMIX_ATTR_MAX_BIND_SIZE);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ATTR_LAZY_FETCH", (long) PDO_INFORMIX_ATTR_LAZY_FETCH);
+
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ISOLATION_DIRTY_READ", (long) PDO_INFORMIX_ISOLATION_DIRTY_READ);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ISOLATION_COMMITTED_READ", (long) PDO_INFORMIX_ISOLATION_COMMITTED_READ);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ISOLATION_LAST_COMMITTED", (long) PDO_INFORMIX_ISOLATION_LAST_COMMITTED);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ISOLATION_CURSOR_STABILITY", (long) PDO_INFORMIX_ISOLATION_CURSOR_STABILITY);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_ISOLATION_REPEATABLE_READ", (long) PDO_INFORMIX_ISOLATION_REPEATABLE_READ);
+
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_TEMPORAL_STRING", (long) PDO_INFORMIX_TEMPORAL_STRING);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_TEMPORAL_ISO8601", (long) PDO_INFORMIX_TEMPORAL_ISO8601);
+	REGISTER_PDO_CLASS_CONST_LONG("INFORMIX_TEMPORAL_UNIX", (long) PDO_INFORMIX_TEMPORAL_UNIX);
+
 	php_pdo_register_driver(&pdo_informix_driver);
 	return TRUE;  
 }
@@ -127,16 +251,24 @@ PHP_MINIT_FUNCTION(pdo_informix)
  */
 PHP_MSHUTDOWN_FUNCTION(pdo_informix)
 {
-	/* uncomment this line if you have INI entries
 	UNREGISTER_INI_ENTRIES();
-	*/
-	 
+
 	php_pdo_unregister_driver(&pdo_informix_driver);
+
+	/*
+	* Drop the module reference; open (persistent) connections keep the
+	* environment and its lock alive, and the last of them frees both.
+	*/
+	if (informix_henv != SQL_NULL_HANDLE) {
+		informix_env_release();
+	} else {
+		/* the environment never came up, so nothing else uses the lock */
+		INFORMIX_ENV_LOCK_FREE();
+	}
 	return TRUE;
 }
 /* }}} */
 
-/* Remove if there's nothing to do at request start */
 /* {{{ PHP_RINIT_FUNCTION
  */
 PHP_RINIT_FUNCTION(pdo_informix)
@@ -145,50 +277,78 @@ PHP_RINIT_FUNCTION(pdo_informix)
 }
 /* }}} */
 
-/* Remove if there's nothing to do at request end */
 /* {{{ PHP_RSHUTDOWN_FUNCTION
  */
 PHP_RSHUTDOWN_FUNCTION(pdo_informix)
 {
+	/* put back the session state of persistent connections used by this request */
+	informix_session_reset_all(TSRMLS_C);
 	return TRUE;
 }
 /* }}} */
 
+/* {{{ informix_stats_array
+ * Fill an array with the driver counters of this process.
+ */
+static void informix_stats_array(zval *stats TSRMLS_DC)
+{
+	array_init(stats);
+	add_assoc_long(stats, "connections_opened", PDO_INFORMIX_G(connections_opened));
+	add_assoc_long(stats, "connections_reused", PDO_INFORMIX_G(connections_reused));
+	add_assoc_long(stats, "liveness_probes", PDO_INFORMIX_G(liveness_probes));
+	add_assoc_long(stats, "statements_prepared", PDO_INFORMIX_G(statements_prepared));
+	add_assoc_long(stats, "executes", PDO_INFORMIX_G(executes));
+	add_assoc_long(stats, "rows_fetched", PDO_INFORMIX_G(rows_fetched));
+	add_assoc_long(stats, "lob_bytes", PDO_INFORMIX_G(lob_bytes));
+	add_assoc_long(stats, "errors", PDO_INFORMIX_G(errors));
+	add_assoc_long(stats, "timed_executes", PDO_INFORMIX_G(timed_executes));
+	add_assoc_double(stats, "execute_time", PDO_INFORMIX_G(execute_time));
+}
+/* }}} */
+
 /* {{{ PHP_MINFO_FUNCTION
  */
 PHP_MINFO_FUNCTION(pdo_informix)
 {
+	zval stats, **entry;
+	char *key;
+	uint key_len;
+	ulong index;
+	HashPosition pos;
+
 	php_info_print_table_start();
 	php_info_print_table_header(2, "pdo_informix support", "enabled");
 	php_info_print_table_row(2, "Module release", PDO_INFORMIX_VERSION);
+#ifdef HAVE_PDO_INFORMIX_MOCK
+	php_info_print_table_row(2, "Client library", "mock (no server access)");
+#endif
+	php_info_print_table_end();
+
+	/* the same counters pdo_informix_get_stats() returns */
+	php_info_print_table_start();
+	php_info_print_table_header(2, "Statistic", "Value");
+	informix_stats_array(&stats TSRMLS_CC);
+	zend_hash_internal_pointer_reset_ex(Z_ARRVAL(stats), &pos);
+	while (zend_hash_get_current_data_ex(Z_ARRVAL(stats), (void **) &entry, &pos) == SUCCESS) {
+		zend_hash_get_current_key_ex(Z_ARRVAL(stats), &key, &key_len, &index, 0, &pos);
+		convert_to_string_ex(entry);
+		php_info_print_table_row(2, key, Z_STRVAL_PP(entry));
+		zend_hash_move_forward_ex(Z_ARRVAL(stats), &pos);
+	}
+	zval_dtor(&stats);
 	php_info_print_table_end();
 
-	/* Remove comments if you have entries in php.ini
 	DISPLAY_INI_ENTRIES();
-	*/
 }
 /* }}} */
 
-
-/* Remove the following function when you have succesfully modified config.m4
-   so that your module can be compiled into PHP, it exists only for testing
-   purposes. */
-
-/* Every user-visible function in PHP should document itself in the source */
-/* {{{ proto string confirm_pdo_informix_compiled(string arg)
-   Return a string to confirm that the module is compiled in */
-PHP_FUNCTION(confirm_pdo_informix_compiled)
+/* {{{ proto array pdo_informix_get_stats()
+   Return the driver counters accumulated by this process */
+PHP_FUNCTION(pdo_informix_get_stats)
 {
-	char *arg = NULL;
-	int arg_len, len;
-	char string[256];
-
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s", &arg, &arg_len) == FALSE)
-	{
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "") == FAILURE) {
 		return;
 	}
-
-	len = sprintf(string, "Congratulations! You have successfully modified ext/%.78s/config.m4. Module %.78s is now compiled into PHP.", "pdo_informix", arg);
-	RETURN_STRINGL(string, len, 1);
+	informix_stats_array(return_value TSRMLS_CC);
 }
 /* }}} */
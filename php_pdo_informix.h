@@ -43,28 +43,36 @@ PHP_RINIT_FUNCTION(pdo_informix);
 PHP_RSHUTDOWN_FUNCTION(pdo_informix);
 PHP_MINFO_FUNCTION(pdo_informix);
 
-PHP_FUNCTION(confirm_pdo_informix_compiled);	/* For testing, remove later. */
-
-/* 
-	Declare any global variables you may need between the BEGIN
-	and END macros here:     
+PHP_FUNCTION(pdo_informix_get_stats);
 
 ZEND_BEGIN_MODULE_GLOBALS(pdo_informix)
-	long  global_value;
-	char *global_string;
+	struct _conn_handle_struct *dirty_conns;	/* persistent connections whose session changed in this request */
+
+	/* counters for the life of the process (or thread), see pdo_informix_get_stats() */
+	long connections_opened;	/* new connections made to the server */
+	long connections_reused;	/* persistent connections handed out again */
+	long liveness_probes;		/* round trips made to check a reused connection */
+	long statements_prepared;	/* successful prepares */
+	long executes;				/* statements executed, PDO::exec() included */
+	long rows_fetched;			/* rows returned by fetches */
+	long lob_bytes;				/* LOB bytes read and written */
+	long errors;				/* errors raised by the driver */
+	long timed_executes;		/* executes timed for the statistics or slow query log */
+	double execute_time;		/* seconds spent in the timed executes */
+
+	/* slow query log, configured through php.ini */
+	long slow_query_threshold;	/* pdo_informix.slow_query_threshold_ms, negative disables the log */
+	char *slow_query_log;		/* pdo_informix.slow_query_log, empty for the PHP error log */
+	zend_bool slow_query_redact;	/* pdo_informix.slow_query_redact */
+
+	/* defaults for new connections, configured through php.ini */
+	long lob_chunk_size;		/* pdo_informix.lob_chunk_size */
+	long liveness_check_interval;	/* pdo_informix.liveness_check_interval */
+	long query_timeout;			/* pdo_informix.query_timeout */
+	long max_bind_size;			/* pdo_informix.max_bind_size */
 ZEND_END_MODULE_GLOBALS(pdo_informix)
-*/
 
-/*
-	In every utility function you add that needs to use variables 
-	in php_pdo_informix_globals, call TSRMLS_FETCH(); after declaring other 
-	variables used by that function, or better yet, pass in TSRMLS_CC
-	after the last function argument and declare your utility function
-	with TSRMLS_DC after the last declared argument.  Always refer to
-	the globals in your function as PDO_INFORMIX_G(variable).  You are 
-	encouraged to rename these macros something shorter, see
-	examples in any other php module directory.
-*/
+ZEND_EXTERN_MODULE_GLOBALS(pdo_informix)
 
 #ifdef ZTS
 #define PDO_INFORMIX_G(v) TSRMG(pdo_informix_globals_id, zend_pdo_informix_globals *, v)
@@ -23,6 +23,7 @@
 #define PHP_PDO_INFORMIX_INT_H
 
 #include "infxcli.h"
+#include "ext/standard/php_smart_str.h"
 
 
 #define MAX_OPTION_LEN 10
@@ -41,8 +42,116 @@
 #define SQL_ATTR_GET_GENERATED_VALUE 2583
 #endif
 
+#ifndef SQL_ATTR_CONNECTION_DEAD
+#define SQL_ATTR_CONNECTION_DEAD 1209
+#endif
+#ifndef SQL_CD_TRUE
+#define SQL_CD_TRUE 1L
+#endif
+
+/* the complex types, reported when NeedODBCTypesOnly is off */
+#ifndef SQL_INFX_RC_ROW
+#define SQL_INFX_RC_ROW			-105
+#define SQL_INFX_RC_COLLECTION	-106
+#define SQL_INFX_RC_LIST		-107
+#define SQL_INFX_RC_SET			-108
+#define SQL_INFX_RC_MULTISET	-109
+#endif
+#define INFORMIX_COMPLEX_TYPE(type) \
+	((type) <= SQL_INFX_RC_ROW && (type) >= SQL_INFX_RC_MULTISET)
+
+/* SQLGetData extensions needed to read some columns next to bound ones */
+#define INFORMIX_GD_MIXED (SQL_GD_ANY_COLUMN | SQL_GD_ANY_ORDER | SQL_GD_BOUND)
+#define INFORMIX_GD_MIXED_OK(conn_res) \
+	(((conn_res)->getdata_ext & INFORMIX_GD_MIXED) == INFORMIX_GD_MIXED)
+
+/* smart large object open modes and seek origins, with the ESQL/C values */
+#ifndef LO_RDONLY
+#define LO_RDONLY	0x04
+#endif
+#ifndef LO_RDWR
+#define LO_RDWR		0x08
+#endif
+#ifndef LO_SEEK_SET
+#define LO_SEEK_SET	0
+#define LO_SEEK_CUR	1
+#define LO_SEEK_END	2
+#endif
+
+/* driver specific attributes, exposed to scripts as PDO::INFORMIX_ATTR_* */
+enum {
+	PDO_INFORMIX_ATTR_LIVENESS_INTERVAL = PDO_ATTR_DRIVER_SPECIFIC,
+	PDO_INFORMIX_ATTR_RESET_ON_REUSE,
+	PDO_INFORMIX_ATTR_ISOLATION,
+	PDO_INFORMIX_ATTR_LOCK_WAIT,
+	PDO_INFORMIX_ATTR_PDQPRIORITY,
+	PDO_INFORMIX_ATTR_OPTCOMPIND,
+	PDO_INFORMIX_ATTR_BEGIN_WORK,
+	PDO_INFORMIX_ATTR_STATS,
+	PDO_INFORMIX_ATTR_LOB_CHUNK_SIZE,
+	PDO_INFORMIX_ATTR_QUERY_TIMEOUT,
+	PDO_INFORMIX_ATTR_TEMPORAL_MODE,
+	PDO_INFORMIX_ATTR_SMART_LOB,
+	PDO_INFORMIX_ATTR_LOB_WRITABLE,
+	PDO_INFORMIX_ATTR_COMPLEX_TYPES,
+	PDO_INFORMIX_ATTR_MAX_BIND_SIZE,
+	PDO_INFORMIX_ATTR_LAZY_FETCH
+};
+
+/* values for PDO_INFORMIX_ATTR_ISOLATION, exposed as PDO::INFORMIX_ISOLATION_* */
+enum {
+	PDO_INFORMIX_ISOLATION_DIRTY_READ = 1,
+	PDO_INFORMIX_ISOLATION_COMMITTED_READ,
+	PDO_INFORMIX_ISOLATION_LAST_COMMITTED,
+	PDO_INFORMIX_ISOLATION_CURSOR_STABILITY,
+	PDO_INFORMIX_ISOLATION_REPEATABLE_READ
+};
+
+/* values for PDO_INFORMIX_ATTR_TEMPORAL_MODE, exposed as PDO::INFORMIX_TEMPORAL_* */
+enum {
+	PDO_INFORMIX_TEMPORAL_STRING = 0,	/* text formatted by the client library */
+	PDO_INFORMIX_TEMPORAL_ISO8601,		/* fetched as a struct, formatted by the driver */
+	PDO_INFORMIX_TEMPORAL_UNIX			/* fetched as a struct, converted to a Unix timestamp */
+};
+#define INFORMIX_TEMPORAL_MODE_VALID(mode) \
+	((mode) >= PDO_INFORMIX_TEMPORAL_STRING && (mode) <= PDO_INFORMIX_TEMPORAL_UNIX)
+
+/*
+* Session settings a request can change on a persistent connection.  With
+* reset on reuse enabled, the ones touched are put back at request end.
+*/
+#define INFORMIX_SESSION_ISOLATION		0x01
+#define INFORMIX_SESSION_LOCK_MODE		0x02
+#define INFORMIX_SESSION_PDQPRIORITY	0x04
+#define INFORMIX_SESSION_OPTCOMPIND		0x08
+#define INFORMIX_SESSION_TEMP_TABLES	0x10
+#define INFORMIX_SESSION_TRANSACTION	0x20
+
+/*
+* The session settings tunable through driver attributes.  Setting n is
+* tracked by the INFORMIX_SESSION_* bit (1 << n).
+*/
+enum {
+	INFORMIX_SETTING_ISOLATION = 0,
+	INFORMIX_SETTING_LOCK_WAIT,
+	INFORMIX_SETTING_PDQPRIORITY,
+	INFORMIX_SETTING_OPTCOMPIND,
+	INFORMIX_SETTING_COUNT
+};
+
+/* a setting nobody asked for, or whose value on the server is unknown */
+#define INFORMIX_SETTING_UNSET LONG_MIN
 
 
+
+/* access to the CLI environment shared by all connections (pdo_informix.c) */
+SQLHANDLE informix_env_acquire(void);
+void informix_env_release(void);
+
+/* session state tracking for persistent connections (informix_driver.c) */
+void informix_session_track(pdo_dbh_t *dbh, const char *sql, long sql_len TSRMLS_DC);
+void informix_session_reset_all(TSRMLS_D);
+
 /* This function is called after executing a stmt for recording lastInsertId */
 int record_last_insert_id( pdo_dbh_t *dbh, SQLHANDLE hstmt TSRMLS_DC);
 
@@ -114,21 +223,55 @@ typedef struct _conn_error_data {
 } conn_error_data;
 
 typedef struct _conn_handle_struct {
-	SQLHANDLE henv;				/* handle to the interface environment */
+	SQLHANDLE henv;				/* the shared interface environment (referenced, not owned) */
 	SQLHANDLE hdbc;				/* the connection handle */
+	SQLHANDLE hstmt_exec;		/* statement handle reused by PDO::exec() */
 	conn_error_data error_data;	/* error handling information */
 	int last_insert_id;			/* the last serial id inserted */
+	long liveness_interval;		/* idle seconds before reuse probes the server (0 = always, < 0 = never) */
+	time_t last_used;			/* when the connection last talked to the server successfully */
+	int reset_on_reuse;			/* restore the session state at request end (persistent only) */
+	unsigned int session_dirty;	/* INFORMIX_SESSION_* settings changed during this request */
+	int session_listed;			/* linked into the request's list of dirty connections */
+	SQLINTEGER txn_isolation;	/* isolation level the session was established with */
+	smart_str temp_tables;		/* DROP statements for the temp tables created in this request */
+	int session_tuned;			/* session settings were requested through attributes */
+	long setting_initial[INFORMIX_SETTING_COUNT];	/* settings requested when the connection was made */
+	long setting_wanted[INFORMIX_SETTING_COUNT];	/* settings currently requested */
+	long setting_applied[INFORMIX_SETTING_COUNT];	/* settings known to be in effect on the server */
+	unsigned int setting_pending;	/* INFORMIX_SESSION_* settings still to be sent */
+	SQLUINTEGER autocommit;		/* the autocommit attribute currently in effect */
+	int begin_work;				/* start transactions with BEGIN WORK, leaving autocommit alone */
+	int in_begin_work;			/* a BEGIN WORK transaction is open */
+	int collect_stats;			/* default PDO::INFORMIX_ATTR_STATS for new statements */
+	long lob_chunk_size;		/* default PDO::INFORMIX_ATTR_LOB_CHUNK_SIZE for new statements */
+	long query_timeout;			/* default PDO::INFORMIX_ATTR_QUERY_TIMEOUT for new statements */
+	int temporal_mode;			/* default PDO::INFORMIX_ATTR_TEMPORAL_MODE for new statements */
+	int smart_lob;				/* queries fetch BLOB/CLOB columns as LO pointers (set at connect) */
+	SQLUSMALLINT lo_ptr_length;	/* size of an LO pointer, in smart LOB mode */
+	int complex_types;			/* collections and ROW values are fetched as arrays (set at connect) */
+	long max_bind_size;			/* default PDO::INFORMIX_ATTR_MAX_BIND_SIZE for new statements */
+	int lazy_fetch;				/* default PDO::INFORMIX_ATTR_LAZY_FETCH for new statements */
+	SQLUINTEGER getdata_ext;	/* SQL_GETDATA_EXTENSIONS of the client library, read at connect */
+	struct _conn_handle_struct *next_dirty;	/* next dirty connection of this request */
 } conn_handle;
 
 /* values used for binding fetched data */
 typedef union {
-	long l_val;		/* long values -- used for all int values, including bools */
+	long l_val;		/* long values -- used for all int values */
 	char *str_val;	/* used for string bindings */
+	zend_bool b_val;	/* BOOLEAN columns, bound as SQL_C_BIT */
 } column_data_value;
 
+struct _column_data;
+
+/* hands PDO a column's value for the current row (see informix_stmt_get_col) */
+typedef int (*informix_get_col_func)(pdo_stmt_t *stmt, int colno, struct _column_data *col_res,
+	char **ptr, unsigned long *len TSRMLS_DC);
+
 /* local descriptor for column data.  These mirror the
    descriptors given back to the PDO driver. */
-typedef struct {
+typedef struct _column_data {
 	char *name;							/* the column name */
 	SQLSMALLINT namelen;				/* length of the column name */
 	SQLSMALLINT data_type;				/* the database column type */
@@ -138,19 +281,123 @@ typedef struct {
 	SQLSMALLINT scale;					/* the scale value */
 	SQLULEN out_length;				/* the transfered data length. Filled in by a fetch */
 	column_data_value data;				/* the transferred data */
+	int owns_str_val;					/* data.str_val was allocated for the column and is freed with it */
+	int temporal_mode;					/* PDO_INFORMIX_TEMPORAL_* the column was bound with */
+	TIMESTAMP_STRUCT ts_val;			/* DATE/DATETIME value bound in binary form */
+	int smart_lob;						/* data.str_val holds an LO pointer for a smart LOB stream */
+	zval *complex_val;					/* collection or ROW value decoded for PDO (PDO_PARAM_ZVAL) */
+	char *complex_type;					/* type name of a collection or ROW column, for the ROW field names */
+	int unbound;						/* not bound; read with SQLGetData when PDO asks for it */
+	SQLSMALLINT unbound_ctype;			/* C type an unbound column is read as */
+	SQLPOINTER unbound_target;			/* where a fixed size unbound column goes, NULL for text */
+	SQLLEN unbound_length;				/* size of unbound_target */
+	SQLULEN buffer_size;				/* allocated size of data.str_val for unbound text */
+	unsigned long fetch_serial;			/* the row an unbound column was last read for */
+	informix_get_col_func get_col;		/* accessor chosen for the column's type when it was bound */
 } column_data;
 
-/* size of the buffer used to read LOB streams */
+/*
+* Per-statement counters, collected only when PDO::INFORMIX_ATTR_STATS is
+* enabled for the statement.  Times are in seconds.
+*/
+typedef struct _informix_stmt_stats {
+	double prepare_time;		/* SQLPrepare and the calls describing the result */
+	double execute_time;		/* SQLExecute */
+	double fetch_time;			/* SQLFetchScroll */
+	double data_time;			/* SQLGetData and SQLParamData/SQLPutData */
+	double describe_time;		/* column description */
+	long cli_calls;				/* CLI calls made for the statement */
+	long rows_fetched;			/* rows returned by the fetches */
+	long lob_bytes;				/* LOB bytes read and written */
+} informix_stmt_stats;
+
+/* monotonic clock used for the statistics, in seconds */
+double informix_clock(void);
+
+/* slow query log (informix_statement.c); a negative threshold turns it off */
+#define INFORMIX_SLOW_QUERY_ENABLED() (PDO_INFORMIX_G(slow_query_threshold) >= 0)
+void informix_slow_query_log(const char *sql, int sql_len, const char *params, long rows,
+	double execute_time, double fetch_time TSRMLS_DC);
+void informix_slow_query_check(pdo_stmt_t *stmt TSRMLS_DC);
+
+/*
+* Time a CLI call made on behalf of a statement.  With statistics off the
+* cost is a single test of the flag.
+*/
+#define INFORMIX_STATS_START(stmt_res, start) \
+	((start) = (stmt_res)->collect_stats ? informix_clock() : 0.0)
+#define INFORMIX_STATS_STOP(stmt_res, field, start, calls) \
+	do { \
+		if ((stmt_res)->collect_stats) { \
+			(stmt_res)->stats.field += informix_clock() - (start); \
+			(stmt_res)->stats.cli_calls += (calls); \
+		} \
+	} while (0)
+#define INFORMIX_STATS_ADD(stmt_res, field, n) \
+	do { \
+		if ((stmt_res)->collect_stats) { \
+			(stmt_res)->stats.field += (n); \
+		} \
+	} while (0)
+
+/*
+* USDT probes (see pdo_informix_dtrace.d).  Without --enable-pdo-informix-dtrace
+* they compile away to nothing.
+*/
+#ifdef HAVE_PDO_INFORMIX_DTRACE
+#include "pdo_informix_dtrace_gen.h"
+#else
+#define PDO_INFORMIX_CONNECT_ENTRY(dbh, dsn)
+#define PDO_INFORMIX_CONNECT_RETURN(dbh, ok)
+#define PDO_INFORMIX_PREPARE_ENTRY(stmt, sql)
+#define PDO_INFORMIX_PREPARE_RETURN(stmt, ok)
+#define PDO_INFORMIX_EXECUTE_ENTRY(stmt, sql)
+#define PDO_INFORMIX_EXECUTE_RETURN(stmt, rows, ok)
+#define PDO_INFORMIX_EXEC_ENTRY(dbh, sql)
+#define PDO_INFORMIX_EXEC_RETURN(dbh, rows, ok)
+#define PDO_INFORMIX_FETCH_ENTRY(stmt)
+#define PDO_INFORMIX_FETCH_RETURN(stmt, rows, found)
+#define PDO_INFORMIX_GETDATA_ENTRY(stmt, colno)
+#define PDO_INFORMIX_GETDATA_RETURN(stmt, colno, bytes)
+#define PDO_INFORMIX_PUTDATA_ENTRY(stmt, bytes)
+#define PDO_INFORMIX_PUTDATA_RETURN(stmt, bytes, ok)
+#define PDO_INFORMIX_COMMIT_ENTRY(dbh)
+#define PDO_INFORMIX_COMMIT_RETURN(dbh, ok)
+#define PDO_INFORMIX_ROLLBACK_ENTRY(dbh)
+#define PDO_INFORMIX_ROLLBACK_RETURN(dbh, ok)
+#endif
+
+/* size of the buffer used to read LOB streams, unless pdo_informix.lob_chunk_size says otherwise */
 #define LOB_BUFFER_SIZE 8192
 
+/* first buffer for a column too wide to bind; it grows to the longest value read */
+#define UNBOUND_BUFFER_SIZE 256
+
 typedef struct _stmt_handle_struct {
 	SQLHANDLE hstmt;					/* the statement handle associated with the stmt */
 	int executing;						/* an executing state flag for error cleanup */
 	char *converted_statement;			/* temporary version of the statement with parameter replacement */
 	char *lob_buffer;					/* buffer used for reading in LOB parameters */
 	column_data *columns;				/* the column descriptors */
+	int columns_described;				/* stmt_describe_columns() has run for this result */
 	enum pdo_cursor_type cursor_type;	/* the type of cursor we support. */
 	SQLSMALLINT server_ver;				/* the server version */
+	int collect_stats;					/* gather the counters below */
+	informix_stmt_stats stats;			/* timing and round-trip counters */
+	int slow_pending;					/* the current execution still has to be checked against the slow query threshold */
+	double slow_execute_time;			/* execute time of the current execution */
+	double slow_fetch_time;				/* fetch time of the current execution so far */
+	smart_str slow_params;				/* parameters of the current execution, as logged */
+	long exec_rows;						/* rows fetched by the current execution so far, for the slow query log and the fetch probe */
+	long lob_chunk_size;				/* bytes moved per SQLPutData/SQLGetData call on LOBs */
+	long query_timeout;					/* SQL_ATTR_QUERY_TIMEOUT in seconds, 0 for none */
+	int temporal_mode;					/* PDO_INFORMIX_TEMPORAL_* for columns described from now on */
+	int smart_lob;						/* a query on a smart LOB connection: BLOB/CLOB come back as LO pointers */
+	int lob_writable;					/* smart LOB streams are opened for reading and writing */
+	long max_bind_size;					/* widest column buffer bound, 0 for no limit */
+	int lazy_fetch;						/* columns are only read when PDO asks for them */
+	int getdata_ordered;				/* SQLGetData only reads columns in increasing order */
+	unsigned long fetch_serial;			/* counts the rows fetched over the statement's life */
 } stmt_handle;
 
 /* Defines the driver_data structure for caching param data */
@@ -161,6 +408,7 @@ typedef struct _param_node {
 	SQLSMALLINT	scale;				/* Decimal scale */
 	SQLSMALLINT ctype;				/* the optimal C type for transfer */
 	SQLULEN  transfer_length;	/* the transfer length of the parameter */
+	unsigned char bit_val;		/* the value of a BOOLEAN parameter, sent as SQL_C_BIT */
 } param_node;
 
 #endif
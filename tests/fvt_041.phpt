@@ -0,0 +1,39 @@
+--TEST--
+pdo_informix: Liveness check interval for persistent connections
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$op = array(PDO::ATTR_PERSISTENT => true,
+						PDO::INFORMIX_ATTR_LIVENESS_INTERVAL => 0);
+			$pdb = new PDO($this->dsn, $this->user, $this->pass, $op);
+			var_dump($pdb->getAttribute(PDO::INFORMIX_ATTR_LIVENESS_INTERVAL));
+			$pdb = null;
+
+			/* the reused handle takes the interval given on this connect */
+			$op[PDO::INFORMIX_ATTR_LIVENESS_INTERVAL] = 300;
+			$pdb = new PDO($this->dsn, $this->user, $this->pass, $op);
+			var_dump($pdb->getAttribute(PDO::INFORMIX_ATTR_LIVENESS_INTERVAL));
+			$stmt = $pdb->query("SELECT count(*) FROM systables WHERE tabid = 1");
+			$res = $stmt->fetch(PDO::FETCH_NUM);
+			echo $res[0]."\n";
+			$pdb = null;
+
+			$this->connect();
+			var_dump($this->db->getAttribute(PDO::INFORMIX_ATTR_LIVENESS_INTERVAL));
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+int(0)
+int(300)
+1
+int(60)
@@ -0,0 +1,86 @@
+--TEST--
+pdo_informix: Session reset on reuse puts a persistent connection's session back
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		/* the session's current isolation level, as the server sees it */
+		public function isolation($db)
+		{
+			$stmt = $db->query("SELECT DBINFO('sessionid'), odb_isolation FROM sysmaster:sysopendb " .
+				"WHERE odb_sessionid = DBINFO('sessionid') AND odb_iscurrent = 'Y'");
+			return $stmt->fetch(PDO::FETCH_NUM);
+		}
+
+		public function runTest()
+		{
+			$op = array(PDO::ATTR_PERSISTENT => true,
+						PDO::INFORMIX_ATTR_RESET_ON_REUSE => true);
+			$pdb = new PDO($this->dsn, $this->user, $this->pass, $op);
+			$pdb->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+			var_dump($pdb->getAttribute(PDO::INFORMIX_ATTR_RESET_ON_REUSE));
+			$initial = $this->isolation($pdb);
+
+			/* change the session */
+			$pdb->exec("SET ISOLATION TO DIRTY READ");
+			$changed = $this->isolation($pdb);
+			var_dump($changed[1] != $initial[1]);
+			$pdb->exec("CREATE TEMP TABLE reset_tmp (id INTEGER)");
+			$pdb->exec("INSERT INTO reset_tmp VALUES (1)");
+			$stmt = $pdb->query("SELECT count(*) FROM reset_tmp");
+			$res = $stmt->fetch(PDO::FETCH_NUM);
+			echo $res[0]."\n";
+			$stmt = null;
+			$pdb = null;
+
+			/* the same session is handed out again, back at its defaults */
+			$pdb = new PDO($this->dsn, $this->user, $this->pass, $op);
+			$pdb->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+			$reused = $this->isolation($pdb);
+			var_dump($reused[0] == $initial[0]);
+			var_dump($reused[1] == $initial[1]);
+			try {
+				$pdb->query("SELECT count(*) FROM reset_tmp");
+				echo "temp table survived\n";
+			} catch (PDOException $e) {
+				echo "temp table dropped\n";
+			}
+
+			/* a second object sharing the live handle leaves its session alone */
+			$pdb->exec("SET ISOLATION TO DIRTY READ");
+			$pdb->exec("CREATE TEMP TABLE shared_tmp (id INTEGER)");
+			$second = new PDO($this->dsn, $this->user, $this->pass, $op);
+			$second->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+			$shared = $this->isolation($pdb);
+			var_dump($shared[0] == $initial[0]);
+			var_dump($shared[1] == $changed[1]);
+			$stmt = $pdb->query("SELECT count(*) FROM shared_tmp");
+			$res = $stmt->fetch(PDO::FETCH_NUM);
+			echo $res[0]."\n";
+			$stmt = null;
+			$second = null;
+			$pdb = null;
+
+			$op = array(PDO::INFORMIX_ATTR_RESET_ON_REUSE => true);
+			$db = new PDO($this->dsn, $this->user, $this->pass, $op);
+			var_dump($db->getAttribute(PDO::INFORMIX_ATTR_RESET_ON_REUSE));
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+bool(true)
+bool(true)
+1
+bool(true)
+bool(true)
+temp table dropped
+bool(true)
+bool(true)
+0
+bool(false)
@@ -0,0 +1,58 @@
+--TEST--
+pdo_informix: Session tuning attributes given at connect time
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$op = array(PDO::INFORMIX_ATTR_ISOLATION => PDO::INFORMIX_ISOLATION_COMMITTED_READ,
+						PDO::INFORMIX_ATTR_LOCK_WAIT => 5,
+						PDO::INFORMIX_ATTR_PDQPRIORITY => 0);
+			$db = new PDO($this->dsn, $this->user, $this->pass, $op);
+			$db->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+			var_dump($db->getAttribute(PDO::INFORMIX_ATTR_ISOLATION) == PDO::INFORMIX_ISOLATION_COMMITTED_READ);
+			var_dump($db->getAttribute(PDO::INFORMIX_ATTR_LOCK_WAIT));
+			var_dump($db->getAttribute(PDO::INFORMIX_ATTR_PDQPRIORITY));
+			var_dump($db->getAttribute(PDO::INFORMIX_ATTR_OPTCOMPIND));
+
+			/* changed settings are sent along with the next statement */
+			$db->setAttribute(PDO::INFORMIX_ATTR_LOCK_WAIT, -1);
+			$db->setAttribute(PDO::INFORMIX_ATTR_OPTCOMPIND, 2);
+			$stmt = $db->query("SELECT count(*) FROM systables WHERE tabid = 1");
+			$res = $stmt->fetch(PDO::FETCH_NUM);
+			echo $res[0]."\n";
+			var_dump($db->getAttribute(PDO::INFORMIX_ATTR_LOCK_WAIT));
+			var_dump($db->getAttribute(PDO::INFORMIX_ATTR_OPTCOMPIND));
+
+			/* a setting changed through SQL is no longer reported */
+			$db->exec("SET LOCK MODE TO NOT WAIT");
+			var_dump($db->getAttribute(PDO::INFORMIX_ATTR_LOCK_WAIT));
+
+			try {
+				$db = new PDO($this->dsn, $this->user, $this->pass,
+					array(PDO::INFORMIX_ATTR_PDQPRIORITY => 101));
+			} catch (Exception $e) {
+				echo "Connection Failed\n";
+				echo $e->getMessage() . "\n";
+			}
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECTF--
+bool(true)
+int(5)
+int(0)
+NULL
+1
+int(-1)
+int(2)
+NULL
+Connection Failed
+SQLSTATE=HY024, setAttribute: 1 Invalid attribute value
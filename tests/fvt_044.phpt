@@ -0,0 +1,57 @@
+--TEST--
+pdo_informix: Transactions opened with BEGIN WORK
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$op = array(PDO::INFORMIX_ATTR_BEGIN_WORK => true);
+			$this->db = new PDO($this->dsn, $this->user, $this->pass, $op);
+			$this->db->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+			var_dump($this->db->getAttribute(PDO::INFORMIX_ATTR_BEGIN_WORK));
+
+			try {
+				$this->db->exec("DROP TABLE animals");
+			} catch (Exception $e) {}
+			$this->db->exec("CREATE TABLE animals (id INTEGER, breed VARCHAR(32))");
+
+			$this->db->beginTransaction();
+			$this->db->exec("INSERT INTO animals VALUES (1, 'cat')");
+			$this->db->rollBack();
+
+			$this->db->beginTransaction();
+			$this->db->exec("INSERT INTO animals VALUES (2, 'dog')");
+			$this->db->commit();
+
+			/* autocommit is back in force once the transaction is over */
+			$this->db->exec("INSERT INTO animals VALUES (3, 'bird')");
+
+			$stmt = $this->db->query("SELECT id, breed FROM animals ORDER BY id");
+			while ($row = $stmt->fetch(PDO::FETCH_NUM)) {
+				echo $row[0] . " " . $row[1] . "\n";
+			}
+
+			$this->db->setAttribute(PDO::INFORMIX_ATTR_BEGIN_WORK, false);
+			var_dump($this->db->getAttribute(PDO::INFORMIX_ATTR_BEGIN_WORK));
+			$this->db->beginTransaction();
+			$this->db->exec("DELETE FROM animals");
+			$this->db->rollBack();
+			$stmt = $this->db->query("SELECT count(*) FROM animals");
+			$row = $stmt->fetch(PDO::FETCH_NUM);
+			echo $row[0] . "\n";
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+bool(true)
+2 dog
+3 bird
+bool(false)
+2
@@ -0,0 +1,57 @@
+--TEST--
+pdo_informix: Transaction savepoints
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->connect();
+			$this->db->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+
+			try {
+				$this->db->exec("DROP TABLE animals");
+			} catch (Exception $e) {}
+			$this->db->exec("CREATE TABLE animals (id INTEGER, breed VARCHAR(32))");
+
+			$this->db->beginTransaction();
+			$this->db->exec("INSERT INTO animals VALUES (1, 'cat')");
+			var_dump($this->db->informixSavepoint("chunk1"));
+			$this->db->exec("INSERT INTO animals VALUES (2, 'dog')");
+			var_dump($this->db->informixRollbackSavepoint("chunk1"));
+			$this->db->exec("INSERT INTO animals VALUES (3, 'bird')");
+			var_dump($this->db->informixSavepoint("chunk2"));
+			$this->db->exec("INSERT INTO animals VALUES (4, 'fish')");
+			var_dump($this->db->informixReleaseSavepoint("chunk2"));
+			$this->db->commit();
+
+			$stmt = $this->db->query("SELECT id, breed FROM animals ORDER BY id");
+			while ($row = $stmt->fetch(PDO::FETCH_NUM)) {
+				echo $row[0] . " " . $row[1] . "\n";
+			}
+
+			$this->db->beginTransaction();
+			try {
+				$this->db->informixSavepoint("bad name; DROP TABLE animals");
+			} catch (PDOException $e) {
+				echo $e->getCode() . "\n";
+			}
+			$this->db->rollBack();
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+1 cat
+3 bird
+4 fish
+42602
@@ -0,0 +1,66 @@
+--TEST--
+pdo_informix: Batch execution of several statements
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->connect();
+			$this->db->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_SILENT);
+
+			$this->db->exec("DROP TABLE animals");
+			$this->db->exec("CREATE TABLE animals (id INTEGER, breed VARCHAR(32))");
+
+			$counts = $this->db->informixExecBatch(array(
+				"INSERT INTO animals VALUES (1, 'cat')",
+				"INSERT INTO animals VALUES (2, 'dog');",
+				"INSERT INTO animals VALUES (3, 'bird')",
+				"UPDATE animals SET breed = 'pet' WHERE id < 3",
+				"DELETE FROM animals WHERE id > 10"));
+			var_dump($counts);
+
+			/* the statement after the failing one is not run */
+			$res = $this->db->informixExecBatch(array(
+				"INSERT INTO animals VALUES (4, 'fish')",
+				"INSERT INTO no_such_table VALUES (5)",
+				"INSERT INTO animals VALUES (6, 'horse')"));
+			var_dump($res);
+			var_dump($this->db->errorCode() != '00000');
+
+			$stmt = $this->db->query("SELECT id, breed FROM animals ORDER BY id");
+			while ($row = $stmt->fetch(PDO::FETCH_NUM)) {
+				echo $row[0] . " " . $row[1] . "\n";
+			}
+
+			var_dump($this->db->informixExecBatch(array()));
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+array(5) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(1)
+  [2]=>
+  int(1)
+  [3]=>
+  int(2)
+  [4]=>
+  int(0)
+}
+bool(false)
+bool(true)
+1 pet
+2 pet
+3 bird
+4 fish
+array(0) {
+}
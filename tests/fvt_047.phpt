@@ -0,0 +1,57 @@
+--TEST--
+pdo_informix: Per-statement statistics
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->connect();
+
+			$stmt = $this->db->prepare("SELECT tabid, tabname FROM systables WHERE tabid < 4 ORDER BY tabid");
+			$stats = $stmt->getAttribute(PDO::INFORMIX_ATTR_STATS);
+			var_dump($stats['enabled'], $stats['cli_calls']);
+
+			$stmt = $this->db->prepare("SELECT tabid, tabname FROM systables WHERE tabid < 4 ORDER BY tabid",
+					array(PDO::INFORMIX_ATTR_STATS => true));
+			$stmt->execute();
+			$rows = $stmt->fetchAll();
+			$stats = $stmt->getAttribute(PDO::INFORMIX_ATTR_STATS);
+			var_dump($stats['enabled']);
+			var_dump($stats['rows_fetched']);
+			var_dump($stats['cli_calls'] > 0);
+			var_dump($stats['execute_time'] >= 0.0 && $stats['fetch_time'] >= 0.0);
+			var_dump($stats['lob_bytes']);
+
+			/* switching collection on again starts from zero */
+			$stmt->setAttribute(PDO::INFORMIX_ATTR_STATS, false);
+			$stmt->setAttribute(PDO::INFORMIX_ATTR_STATS, true);
+			$stats = $stmt->getAttribute(PDO::INFORMIX_ATTR_STATS);
+			var_dump($stats['rows_fetched']);
+
+			/* the connection supplies the default for new statements */
+			$this->db->setAttribute(PDO::INFORMIX_ATTR_STATS, true);
+			$stmt = $this->db->query("SELECT tabid FROM systables WHERE tabid = 1");
+			$stmt->fetch();
+			$stats = $stmt->getAttribute(PDO::INFORMIX_ATTR_STATS);
+			var_dump($stats['enabled'], $stats['rows_fetched']);
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+bool(false)
+int(0)
+bool(true)
+int(3)
+bool(true)
+bool(true)
+int(0)
+int(0)
+bool(true)
+int(1)
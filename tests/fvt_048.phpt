@@ -0,0 +1,55 @@
+--TEST--
+pdo_informix: Process-wide driver statistics
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--INI--
+pdo_informix.slow_query_threshold_ms=-1
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$before = pdo_informix_get_stats();
+			echo implode(",", array_keys($before)) . "\n";
+
+			$this->connect();
+			$stmt = $this->db->prepare("SELECT tabid FROM systables WHERE tabid < 4");
+			$stmt->execute();
+			$stmt->fetchAll();
+			$this->db->exec("SET LOCK MODE TO NOT WAIT");
+			try {
+				$this->db->exec("SELECT * FROM no_such_table");
+			} catch (PDOException $e) {}
+
+			$after = pdo_informix_get_stats();
+			var_dump($after['connections_opened'] - $before['connections_opened']);
+			var_dump($after['statements_prepared'] - $before['statements_prepared']);
+			var_dump($after['executes'] - $before['executes']);
+			var_dump($after['rows_fetched'] - $before['rows_fetched']);
+			var_dump($after['errors'] > $before['errors']);
+			var_dump($after['execute_time'] >= $before['execute_time']);
+			/* only timed executes count towards execute_time */
+			var_dump($after['timed_executes'] - $before['timed_executes']);
+
+			$this->db->setAttribute(PDO::INFORMIX_ATTR_STATS, true);
+			$this->db->exec("SET LOCK MODE TO NOT WAIT");
+			$timed = pdo_informix_get_stats();
+			var_dump($timed['timed_executes'] - $after['timed_executes']);
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+connections_opened,connections_reused,liveness_probes,statements_prepared,executes,rows_fetched,lob_bytes,errors,timed_executes,execute_time
+int(1)
+int(1)
+int(3)
+int(3)
+bool(true)
+bool(true)
+int(0)
+int(1)
@@ -0,0 +1,56 @@
+--TEST--
+pdo_informix: Slow query log
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--INI--
+pdo_informix.slow_query_threshold_ms=0
+pdo_informix.slow_query_log={PWD}/fvt_049.log
+pdo_informix.slow_query_redact=0
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$log = dirname(__FILE__) . "/fvt_049.log";
+			@unlink($log);
+
+			/* a threshold of 0 logs every statement */
+			$this->connect();
+			$this->db->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_SILENT);
+			$stmt = $this->db->prepare("SELECT tabname FROM systables WHERE tabid = ?");
+			$stmt->execute(array(1));
+			$stmt->fetchAll();
+
+			/* logged when the statement goes, with the parameters it ran with */
+			$stmt->execute(array(2));
+			$stmt = null;
+
+			/* failures are logged too */
+			$this->db->exec("DELETE FROM no_such_table");
+
+			/* a negative threshold turns the log off */
+			ini_set('pdo_informix.slow_query_threshold_ms', -1);
+			$stmt = $this->db->prepare("SELECT tabname FROM systables WHERE tabid = ?");
+			$stmt->execute(array(3));
+			$stmt->fetchAll();
+			$stmt = null;
+
+			$lines = file($log);
+			echo count($lines) . "\n";
+			foreach ($lines as $line) {
+				echo preg_replace('/^.*\), /', '', $line);
+			}
+			@unlink($log);
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+3
+1 rows: SELECT tabname FROM systables WHERE tabid = ? [1 => '1']
+0 rows: SELECT tabname FROM systables WHERE tabid = ? [1 => '2']
+failed: DELETE FROM no_such_table
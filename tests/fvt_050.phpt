@@ -0,0 +1,60 @@
+--TEST--
+pdo_informix: php.ini defaults for the LOB chunk size, liveness interval and query timeout
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--INI--
+pdo_informix.lob_chunk_size=32768
+pdo_informix.liveness_check_interval=5
+pdo_informix.query_timeout=30
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->connect();
+			var_dump($this->db->getAttribute(PDO::INFORMIX_ATTR_LOB_CHUNK_SIZE));
+			var_dump($this->db->getAttribute(PDO::INFORMIX_ATTR_LIVENESS_INTERVAL));
+			var_dump($this->db->getAttribute(PDO::INFORMIX_ATTR_QUERY_TIMEOUT));
+
+			/* the connection passes its settings on to its statements */
+			$this->db->setAttribute(PDO::INFORMIX_ATTR_QUERY_TIMEOUT, 10);
+			$stmt = $this->db->prepare("SELECT tabid FROM systables WHERE tabid = 1");
+			var_dump($stmt->getAttribute(PDO::INFORMIX_ATTR_LOB_CHUNK_SIZE));
+			var_dump($stmt->getAttribute(PDO::INFORMIX_ATTR_QUERY_TIMEOUT));
+
+			/* which can override them */
+			$stmt = $this->db->prepare("SELECT tabid FROM systables WHERE tabid = 1",
+				array(PDO::INFORMIX_ATTR_LOB_CHUNK_SIZE => 1024));
+			$stmt->setAttribute(PDO::INFORMIX_ATTR_QUERY_TIMEOUT, 0);
+			var_dump($stmt->getAttribute(PDO::INFORMIX_ATTR_LOB_CHUNK_SIZE));
+			var_dump($stmt->getAttribute(PDO::INFORMIX_ATTR_QUERY_TIMEOUT));
+			$stmt->execute();
+			var_dump($stmt->fetchColumn());
+
+			try {
+				$this->db->setAttribute(PDO::INFORMIX_ATTR_LOB_CHUNK_SIZE, 0);
+			} catch (PDOException $e) {
+				echo $e->getCode() . "\n";
+			}
+			var_dump(ini_set('pdo_informix.lob_chunk_size', -1));
+			var_dump(ini_get('pdo_informix.lob_chunk_size'));
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+int(32768)
+int(5)
+int(30)
+int(32768)
+int(10)
+int(1024)
+int(0)
+string(1) "1"
+HY024
+bool(false)
+string(5) "32768"
@@ -0,0 +1,87 @@
+--TEST--
+pdo_informix: DATE and DATETIME columns fetched in binary form
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--INI--
+date.timezone=UTC
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->connect();
+			try {
+				$this->db->exec("DROP TABLE temporal");
+			} catch (Exception $e) {}
+			$this->db->exec("CREATE TABLE temporal (id INTEGER, d DATE, ts DATETIME YEAR TO SECOND, tf DATETIME YEAR TO FRACTION(3))");
+			$this->db->exec("INSERT INTO temporal VALUES (1, MDY(7, 4, 2026), DATETIME(2026-07-04 13:45:30) YEAR TO SECOND, DATETIME(2026-07-04 13:45:30.250) YEAR TO FRACTION(3))");
+			$this->db->exec("INSERT INTO temporal VALUES (2, NULL, NULL, NULL)");
+			$this->db->setAttribute(PDO::ATTR_STRINGIFY_FETCHES, false);
+
+			var_dump($this->db->getAttribute(PDO::INFORMIX_ATTR_TEMPORAL_MODE) == PDO::INFORMIX_TEMPORAL_STRING);
+
+			$this->db->setAttribute(PDO::INFORMIX_ATTR_TEMPORAL_MODE, PDO::INFORMIX_TEMPORAL_ISO8601);
+			$stmt = $this->db->query("SELECT d, ts, tf FROM temporal ORDER BY id");
+			var_dump($stmt->fetchAll(PDO::FETCH_NUM));
+
+			$stmt = $this->db->prepare("SELECT d, ts, tf FROM temporal ORDER BY id",
+				array(PDO::INFORMIX_ATTR_TEMPORAL_MODE => PDO::INFORMIX_TEMPORAL_UNIX));
+			$stmt->execute();
+			var_dump($stmt->fetchAll(PDO::FETCH_NUM));
+
+			try {
+				$this->db->setAttribute(PDO::INFORMIX_ATTR_TEMPORAL_MODE, 7);
+			} catch (PDOException $e) {
+				echo $e->getCode() . "\n";
+			}
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+bool(true)
+array(2) {
+  [0]=>
+  array(3) {
+    [0]=>
+    string(10) "2026-07-04"
+    [1]=>
+    string(19) "2026-07-04T13:45:30"
+    [2]=>
+    string(23) "2026-07-04T13:45:30.250"
+  }
+  [1]=>
+  array(3) {
+    [0]=>
+    NULL
+    [1]=>
+    NULL
+    [2]=>
+    NULL
+  }
+}
+array(2) {
+  [0]=>
+  array(3) {
+    [0]=>
+    int(1783123200)
+    [1]=>
+    int(1783172730)
+    [2]=>
+    int(1783172730)
+  }
+  [1]=>
+  array(3) {
+    [0]=>
+    NULL
+    [1]=>
+    NULL
+    [2]=>
+    NULL
+  }
+}
+HY024
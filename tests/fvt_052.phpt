@@ -0,0 +1,51 @@
+--TEST--
+pdo_informix: BOOLEAN columns and parameters as PHP booleans
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->connect();
+			try {
+				$this->db->exec("DROP TABLE flags");
+			} catch (Exception $e) {}
+			$this->db->exec("CREATE TABLE flags (id INTEGER, flag BOOLEAN)");
+			$this->db->setAttribute(PDO::ATTR_STRINGIFY_FETCHES, false);
+
+			$stmt = $this->db->prepare("INSERT INTO flags (id, flag) VALUES (?, ?)");
+			$stmt->execute(array(1, true));
+			$stmt->execute(array(2, 0));
+			$stmt->execute(array(3, 'f'));
+			$stmt->execute(array(4, 't'));
+			$stmt->execute(array(5, null));
+			$stmt->bindValue(1, 6, PDO::PARAM_INT);
+			$stmt->bindValue(2, false, PDO::PARAM_BOOL);
+			$stmt->execute();
+
+			$stmt = $this->db->query("SELECT id, flag FROM flags ORDER BY id");
+			foreach ($stmt->fetchAll(PDO::FETCH_NUM) as $row) {
+				echo $row[0] . ": ";
+				var_dump($row[1]);
+			}
+
+			$stmt = $this->db->prepare("SELECT count(*) FROM flags WHERE flag = ?");
+			$stmt->execute(array(true));
+			var_dump($stmt->fetchColumn());
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+1: bool(true)
+2: bool(false)
+3: bool(false)
+4: bool(true)
+5: NULL
+6: bool(false)
+string(1) "2"
@@ -0,0 +1,66 @@
+--TEST--
+pdo_informix: Seek, ranged reads and in-place writes on smart LOB streams
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->connect();
+			try {
+				$this->db->exec("DROP TABLE media");
+			} catch (Exception $e) {}
+			$this->db->exec("CREATE TABLE media (id INTEGER, body BLOB)");
+			$stmt = $this->db->prepare("INSERT INTO media (id, body) VALUES (?, ?)");
+			$stmt->bindValue(1, 1, PDO::PARAM_INT);
+			$stmt->bindValue(2, str_repeat('abcdefghijklmnopqrstuvwxyz', 4), PDO::PARAM_LOB);
+			$stmt->execute();
+
+			$smart = new PDO($this->dsn, $this->user, $this->pass,
+				array(PDO::INFORMIX_ATTR_SMART_LOB => true));
+			$smart->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+			var_dump($smart->getAttribute(PDO::INFORMIX_ATTR_SMART_LOB));
+
+			/* ranged reads */
+			$stmt = $smart->query("SELECT body FROM media WHERE id = 1");
+			$stmt->bindColumn(1, $lob, PDO::PARAM_LOB);
+			$stmt->fetch(PDO::FETCH_BOUND);
+			fseek($lob, 50);
+			var_dump(fread($lob, 10));
+			var_dump(ftell($lob));
+			fseek($lob, -4, SEEK_END);
+			var_dump(stream_get_contents($lob));
+			var_dump(@fwrite($lob, 'x'));
+			fclose($lob);
+
+			/* in-place write */
+			$smart->beginTransaction();
+			$stmt = $smart->prepare("SELECT body FROM media WHERE id = 1",
+				array(PDO::INFORMIX_ATTR_LOB_WRITABLE => true));
+			$stmt->execute();
+			$stmt->bindColumn(1, $lob, PDO::PARAM_LOB);
+			$stmt->fetch(PDO::FETCH_BOUND);
+			fseek($lob, 10);
+			var_dump(fwrite($lob, 'XYZ'));
+			fclose($lob);
+			$smart->commit();
+
+			$stmt = $this->db->query("SELECT body FROM media WHERE id = 1");
+			var_dump(substr($stmt->fetchColumn(), 5, 10));
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+bool(true)
+string(10) "yzabcdefgh"
+int(60)
+string(4) "wxyz"
+int(0)
+int(3)
+string(10) "fghijXYZno"
@@ -0,0 +1,64 @@
+--TEST--
+pdo_informix: Smart LOBs selected FOR UPDATE are writable in place
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->connect();
+			try {
+				$this->db->exec("DROP TABLE journal");
+			} catch (Exception $e) {}
+			$this->db->exec("CREATE TABLE journal (id INTEGER, entries CLOB, notes TEXT)");
+			$stmt = $this->db->prepare("INSERT INTO journal (id, entries, notes) VALUES (?, ?, ?)");
+			$stmt->bindValue(1, 1, PDO::PARAM_INT);
+			$stmt->bindValue(2, "first\n", PDO::PARAM_LOB);
+			$stmt->bindValue(3, "notes\n", PDO::PARAM_LOB);
+			$stmt->execute();
+
+			/* TEXT cannot be patched in place */
+			$stmt = $this->db->query("SELECT notes FROM journal WHERE id = 1");
+			$stmt->bindColumn(1, $notes, PDO::PARAM_LOB);
+			$stmt->fetch(PDO::FETCH_BOUND);
+			var_dump(@fwrite($notes, "more\n"));
+			$stmt->closeCursor();
+
+			$smart = new PDO($this->dsn, $this->user, $this->pass,
+				array(PDO::INFORMIX_ATTR_SMART_LOB => true));
+			$smart->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+
+			$stmt = $smart->prepare("SELECT entries FROM journal WHERE id = 1");
+			var_dump($stmt->getAttribute(PDO::INFORMIX_ATTR_LOB_WRITABLE));
+
+			/* append to the log without sending what is already there */
+			$smart->beginTransaction();
+			$stmt = $smart->prepare("SELECT entries FROM journal WHERE id = 1 FOR UPDATE");
+			var_dump($stmt->getAttribute(PDO::INFORMIX_ATTR_LOB_WRITABLE));
+			$stmt->execute();
+			$stmt->bindColumn(1, $entries, PDO::PARAM_LOB);
+			$stmt->fetch(PDO::FETCH_BOUND);
+			fseek($entries, 0, SEEK_END);
+			var_dump(fwrite($entries, "second\n"));
+			fclose($entries);
+			$smart->commit();
+
+			$stmt = $this->db->query("SELECT entries FROM journal WHERE id = 1");
+			var_dump($stmt->fetchColumn());
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+int(0)
+bool(false)
+bool(true)
+int(7)
+string(13) "first
+second
+"
@@ -0,0 +1,64 @@
+--TEST--
+pdo_informix: Collection and ROW columns fetched as arrays
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->connect();
+			try {
+				$this->db->exec("DROP TABLE catalog");
+			} catch (Exception $e) {}
+			$this->db->exec("CREATE TABLE catalog (id INTEGER, tags MULTISET(VARCHAR(20) NOT NULL), " .
+				"size ROW(w INTEGER, h INTEGER), history LIST(SET(INTEGER NOT NULL) NOT NULL))");
+			$this->db->exec("INSERT INTO catalog VALUES (1, MULTISET{'it''s'}, ROW(2, NULL), " .
+				"LIST{SET{7}, SET{}})");
+
+			/* without the mode, the literals come back as text */
+			$stmt = $this->db->query("SELECT tags FROM catalog WHERE id = 1");
+			var_dump($stmt->fetchColumn());
+
+			$db = new PDO($this->dsn, $this->user, $this->pass,
+				array(PDO::INFORMIX_ATTR_COMPLEX_TYPES => true));
+			$db->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+			var_dump($db->getAttribute(PDO::INFORMIX_ATTR_COMPLEX_TYPES));
+			$stmt = $db->query("SELECT tags, size, history FROM catalog WHERE id = 1");
+			var_dump($stmt->fetch(PDO::FETCH_NUM));
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+string(17) "MULTISET{'it''s'}"
+bool(true)
+array(3) {
+  [0]=>
+  array(1) {
+    [0]=>
+    string(4) "it's"
+  }
+  [1]=>
+  array(2) {
+    ["w"]=>
+    string(1) "2"
+    ["h"]=>
+    NULL
+  }
+  [2]=>
+  array(2) {
+    [0]=>
+    array(1) {
+      [0]=>
+      string(1) "7"
+    }
+    [1]=>
+    array(0) {
+    }
+  }
+}
@@ -0,0 +1,62 @@
+--TEST--
+pdo_informix: Columns wider than the maximum bind size are read with SQLGetData
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--INI--
+pdo_informix.max_bind_size=4096
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->connect();
+			var_dump($this->db->getAttribute(PDO::INFORMIX_ATTR_MAX_BIND_SIZE));
+			try {
+				$this->db->exec("DROP TABLE notes");
+			} catch (Exception $e) {}
+			$this->db->exec("CREATE TABLE notes (id INTEGER, title VARCHAR(40), body LVARCHAR(30000))");
+			$insert = $this->db->prepare("INSERT INTO notes VALUES (?, ?, ?)");
+			$insert->execute(array(1, 'short', 'a few words'));
+			$insert->execute(array(2, 'long', str_repeat('0123456789', 2000)));
+			$insert->execute(array(3, 'empty', ''));
+			$insert->execute(array(4, 'null', null));
+
+			/* the buffer grows for the long value and is reused for the rest */
+			$stmt = $this->db->query("SELECT id, title, body FROM notes ORDER BY id");
+			var_dump($stmt->getAttribute(PDO::INFORMIX_ATTR_MAX_BIND_SIZE));
+			$stmt->bindColumn(3, $body);
+			while ($row = $stmt->fetch(PDO::FETCH_NUM)) {
+				printf("%d %s %s %s\n", $row[0], $row[1],
+					is_null($row[2]) ? 'NULL' : strlen($row[2]), md5($row[2]) == md5($body) ? 'same' : 'differs');
+			}
+
+			/* 0 binds every column */
+			$stmt = $this->db->prepare("SELECT body FROM notes WHERE id = 2",
+				array(PDO::INFORMIX_ATTR_MAX_BIND_SIZE => 0));
+			var_dump($stmt->getAttribute(PDO::INFORMIX_ATTR_MAX_BIND_SIZE));
+			$stmt->execute();
+			var_dump(strlen($stmt->fetchColumn()));
+
+			try {
+				$stmt->setAttribute(PDO::INFORMIX_ATTR_MAX_BIND_SIZE, -1);
+			} catch (PDOException $e) {
+				echo $e->getCode() . "\n";
+			}
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+int(4096)
+int(4096)
+1 short 11 same
+2 long 20000 same
+3 empty 0 same
+4 null NULL same
+int(0)
+int(20000)
+HY024
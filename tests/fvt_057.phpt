@@ -0,0 +1,78 @@
+--TEST--
+pdo_informix: Lazy fetch mode reads only the columns asked for
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->connect();
+			try {
+				$this->db->exec("DROP TABLE orders");
+			} catch (Exception $e) {}
+			$this->db->exec("CREATE TABLE orders (id INTEGER, customer VARCHAR(40), shipped BOOLEAN, " .
+				"placed DATE, amount DECIMAL(10,2), notes LVARCHAR(2000))");
+			$insert = $this->db->prepare("INSERT INTO orders VALUES (?, ?, ?, ?, ?, ?)");
+			$insert->execute(array(1, 'Smith', 't', '01/15/2026', 10.5, str_repeat('x', 1500)));
+			$insert->execute(array(2, 'Jones', 'f', '02/20/2026', 200, null));
+			$insert->execute(array(3, '', 't', null, null, 'short'));
+
+			$sql = "SELECT id, customer, shipped, placed, amount, notes FROM orders ORDER BY id";
+			$eager = $this->db->query($sql)->fetchAll(PDO::FETCH_NUM);
+
+			$this->db->setAttribute(PDO::INFORMIX_ATTR_LAZY_FETCH, true);
+			var_dump($this->db->getAttribute(PDO::INFORMIX_ATTR_LAZY_FETCH));
+			$stmt = $this->db->prepare($sql);
+			var_dump($stmt->getAttribute(PDO::INFORMIX_ATTR_LAZY_FETCH));
+
+			/* every column, read on demand, comes back the same */
+			$stmt->execute();
+			var_dump($stmt->fetchAll(PDO::FETCH_NUM) === $eager);
+
+			/* a single column */
+			$stmt->execute();
+			while (($customer = $stmt->fetchColumn(1)) !== false) {
+				var_dump($customer);
+			}
+
+			/* a subset of bound columns, asked for out of order */
+			$stmt->execute();
+			$stmt->bindColumn(6, $notes);
+			$stmt->bindColumn(3, $shipped);
+			while ($row = $stmt->fetch(PDO::FETCH_BOUND)) {
+				printf("%s %s\n", is_null($notes) ? 'NULL' : strlen($notes), $shipped ? 'shipped' : 'open');
+			}
+
+			/* a higher column read before a lower one, in the same row */
+			$stmt = $this->db->prepare($sql);
+			$stmt->execute();
+			$stmt->bindColumn(5, $amount);
+			$stmt->bindColumn(2, $customer);
+			$stmt->bindColumn(1, $id);
+			$i = 0;
+			while ($row = $stmt->fetch(PDO::FETCH_BOUND)) {
+				var_dump(array($id, $customer, $amount) === array($eager[$i][0], $eager[$i][1], $eager[$i][4]));
+				$i++;
+			}
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+string(5) "Smith"
+string(5) "Jones"
+string(0) ""
+1500 shipped
+NULL open
+5 shipped
+bool(true)
+bool(true)
+bool(true)
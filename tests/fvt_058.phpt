@@ -0,0 +1,95 @@
+--TEST--
+pdo_informix: Columns of a wide result are described in one pass
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->connect();
+			try {
+				$this->db->exec("DROP TABLE wide_describe");
+			} catch (Exception $e) {}
+			$columns = array("code CHAR(10)", "label VARCHAR(30)", "qty SMALLINT", "amount DECIMAL(8,2)",
+				"placed DATE", "shipped BOOLEAN");
+			for ($i = 0; $i < 60; $i++) {
+				$columns[] = "extra_column_with_a_long_name_$i INTEGER";
+			}
+			$this->db->exec("CREATE TABLE wide_describe (" . implode(', ', $columns) . ")");
+			$this->db->exec("INSERT INTO wide_describe (code, label, qty, amount, placed, shipped, " .
+				"extra_column_with_a_long_name_59) VALUES ('A1', 'first', 3, 12.5, '01/15/2026', 't', 59)");
+
+			$stmt = $this->db->query("SELECT * FROM wide_describe");
+			var_dump($stmt->columnCount());
+			foreach (array(0, 1, 2, 3, 4, 65) as $colno) {
+				$meta = $stmt->getColumnMeta($colno);
+				printf("%s %d %d\n", $meta['name'], $meta['len'], $meta['scale']);
+			}
+			$row = $stmt->fetch(PDO::FETCH_ASSOC);
+			var_dump($row['label'], $row['extra_column_with_a_long_name_59']);
+
+			/* PDO folds its own copy of the names */
+			$this->db->setAttribute(PDO::ATTR_CASE, PDO::CASE_UPPER);
+			$stmt = $this->db->query("SELECT code, extra_column_with_a_long_name_59 FROM wide_describe");
+			var_dump($stmt->fetch(PDO::FETCH_ASSOC));
+			$meta = $stmt->getColumnMeta(1);
+			var_dump($meta['name']);
+
+			/* a result made mostly of character columns */
+			try {
+				$this->db->exec("DROP TABLE wide_text");
+			} catch (Exception $e) {}
+			$types = array("CHAR", "VARCHAR", "NCHAR", "LVARCHAR");
+			$columns = array("id INTEGER");
+			for ($i = 0; $i < 40; $i++) {
+				$columns[] = "t$i " . $types[$i % 4] . "(" . (10 + $i) . ")";
+			}
+			$this->db->exec("CREATE TABLE wide_text (" . implode(', ', $columns) . ")");
+			$this->db->exec("INSERT INTO wide_text (id, t0, t1, t2, t39) VALUES (1, 'x', 'y', 'z', 'last')");
+
+			$this->db->setAttribute(PDO::ATTR_CASE, PDO::CASE_NATURAL);
+			$stmt = $this->db->query("SELECT * FROM wide_text");
+			var_dump($stmt->columnCount());
+			foreach (array(1, 2, 3, 4, 40) as $colno) {
+				$meta = $stmt->getColumnMeta($colno);
+				printf("%s %d\n", $meta['name'], $meta['len']);
+			}
+			$row = $stmt->fetch(PDO::FETCH_ASSOC);
+			var_dump($row['t0'], $row['t1'], $row['t2'], $row['t3'], $row['t39']);
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+int(66)
+code 10 0
+label 30 0
+qty 6 0
+amount 10 2
+placed 10 0
+extra_column_with_a_long_name_59 11 0
+string(5) "first"
+string(2) "59"
+array(2) {
+  ["CODE"]=>
+  string(10) "A1        "
+  ["EXTRA_COLUMN_WITH_A_LONG_NAME_59"]=>
+  string(2) "59"
+}
+string(32) "EXTRA_COLUMN_WITH_A_LONG_NAME_59"
+int(41)
+t0 10
+t1 11
+t2 12
+t3 13
+t39 49
+string(10) "x         "
+string(1) "y"
+string(12) "z           "
+NULL
+string(4) "last"
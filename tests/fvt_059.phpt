@@ -0,0 +1,65 @@
+--TEST--
+pdo_informix: BLOB and CLOB parameters bind from strings and streams on a smart LOB connection
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->db = new PDO($this->dsn, $this->user, $this->pass,
+				array(PDO::INFORMIX_ATTR_SMART_LOB => true));
+			$this->db->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+			try {
+				$this->db->exec("DROP TABLE attachments");
+			} catch (Exception $e) {}
+			$this->db->exec("CREATE TABLE attachments (id INTEGER, body BLOB, caption CLOB)");
+
+			$stmt = $this->db->prepare("INSERT INTO attachments (id, body, caption) VALUES (?, ?, ?)");
+			$stmt->bindValue(1, 1, PDO::PARAM_INT);
+			$stmt->bindValue(2, "\x00\x01binary\x02", PDO::PARAM_LOB);
+			$stmt->bindValue(3, "first caption", PDO::PARAM_LOB);
+			$stmt->execute();
+
+			$fp = fopen('php://memory', 'w+b');
+			fwrite($fp, str_repeat('0123456789', 10));
+			rewind($fp);
+			$stmt->bindValue(1, 2, PDO::PARAM_INT);
+			$stmt->bindParam(2, $fp, PDO::PARAM_LOB);
+			$stmt->bindValue(3, "second caption", PDO::PARAM_LOB);
+			$stmt->execute();
+
+			$stmt = $this->db->prepare("UPDATE attachments SET caption = ? WHERE id = 1");
+			$stmt->bindValue(1, "updated caption", PDO::PARAM_LOB);
+			$stmt->execute();
+
+			/* only the rows whose streams are read open their objects */
+			$stmt = $this->db->query("SELECT id, body, caption FROM attachments ORDER BY id");
+			$stmt->bindColumn(1, $id);
+			$stmt->bindColumn(2, $body, PDO::PARAM_LOB);
+			$stmt->bindColumn(3, $caption, PDO::PARAM_LOB);
+			while ($stmt->fetch(PDO::FETCH_BOUND)) {
+				var_dump($id);
+				if ($id == 1) {
+					var_dump(bin2hex(stream_get_contents($body)));
+				} else {
+					fseek($body, 95);
+					var_dump(fread($body, 10));
+				}
+				var_dump(stream_get_contents($caption));
+			}
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+string(1) "1"
+string(18) "000162696e61727902"
+string(15) "updated caption"
+string(1) "2"
+string(5) "56789"
+string(14) "second caption"
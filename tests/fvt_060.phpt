@@ -0,0 +1,65 @@
+--TEST--
+pdo_informix: Batch statements are kept apart and a failing one is identified
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$this->connect();
+			$this->db->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_SILENT);
+
+			$this->db->exec("DROP TABLE animals");
+			$this->db->exec("CREATE TABLE animals (id INTEGER, breed VARCHAR(32))");
+
+			var_dump($this->db->informixExecBatch(array(
+				"INSERT INTO animals VALUES (1, 'cat')",
+				"INSERT INTO no_such_table VALUES (2)",
+				"INSERT INTO animals VALUES (3, 'dog')")));
+			$info = $this->db->errorInfo();
+			var_dump($info[0]);
+			var_dump(strpos($info[2], "Statement 1 of the batch: ") === 0);
+
+			$this->db->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+			try {
+				$this->db->informixExecBatch(array(
+					"INSERT INTO animals VALUES (4, 'fish')",
+					"INSERT INTO no_such_table VALUES (5)",
+					"INSERT INTO animals VALUES (6, 'horse')"));
+			} catch (PDOException $e) {
+				var_dump(strpos($e->getMessage(), "Statement 1 of the batch: ") !== false);
+			}
+
+			/* a trailing line comment does not hide the statement after it */
+			var_dump($this->db->informixExecBatch(array(
+				"INSERT INTO animals VALUES (7, 'bird') -- first",
+				"INSERT INTO animals VALUES (8, 'frog')")));
+
+			$stmt = $this->db->query("SELECT id, breed FROM animals ORDER BY id");
+			while ($row = $stmt->fetch(PDO::FETCH_NUM)) {
+				echo $row[0] . " " . $row[1] . "\n";
+			}
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+bool(false)
+string(5) "42S02"
+bool(true)
+bool(true)
+array(2) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(1)
+}
+1 cat
+4 fish
+7 bird
+8 frog
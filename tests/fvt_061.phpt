@@ -0,0 +1,44 @@
+--TEST--
+pdo_informix: Slow query log redacts parameter values by default
+--SKIPIF--
+<?php require_once('skipif.inc'); ?>
+--INI--
+pdo_informix.slow_query_threshold_ms=0
+pdo_informix.slow_query_log={PWD}/fvt_061.log
+--FILE--
+<?php
+	require_once('fvt.inc');
+	class Test extends FVTTest
+	{
+		public function runTest()
+		{
+			$log = dirname(__FILE__) . "/fvt_061.log";
+			@unlink($log);
+
+			$this->connect();
+			$stmt = $this->db->prepare("SELECT tabname FROM systables WHERE tabid = :id");
+			$stmt->execute(array(':id' => 1));
+			$stmt->fetchAll();
+
+			/* the setting can only be made in php.ini */
+			var_dump(ini_set('pdo_informix.slow_query_redact', 0));
+			$stmt->execute(array(':id' => 1));
+			$stmt->fetchAll();
+
+			$lines = file($log);
+			echo count($lines) . "\n";
+			foreach ($lines as $line) {
+				echo preg_replace('/^.*\), /', '', $line);
+			}
+			@unlink($log);
+		}
+	}
+
+	$testcase = new Test();
+	$testcase->runTest();
+?>
+--EXPECT--
+bool(false)
+2
+1 rows: SELECT tabname FROM systables WHERE tabid = :id [:id => ?]
+1 rows: SELECT tabname FROM systables WHERE tabid = :id [:id => ?]